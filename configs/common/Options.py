@@ -231,6 +231,10 @@ def addCommonOptions(parser):
                       help="""Data dependency trace file input to
                       Elastic Trace probe in a capture simulation and
                       Trace CPU in a replay simulation""", default="")
+    parser.add_option("--trace-cache-dir", action="store", type="string",
+                      help="""Directory in which the Trace CPU caches the
+                      decoded traces for later replay simulations""",
+                      default="")
 
     parser.add_option("-l", "--lpae", action="store_true")
     parser.add_option("-V", "--virtualisation", action="store_true")
@@ -0,0 +1,80 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replay a branch trace through one or more branch predictors without
+# simulating a CPU. Traces are recorded by attaching a BranchTraceProbe
+# to an AtomicSimpleCPU, e.g.
+#
+#   cpu.branch_trace = BranchTraceProbe(manager=cpu)
+#
+# and the results are reported as the predictors' statistics and the
+# per-predictor misprediction counts and MPKI of the replayer.
+
+from __future__ import print_function
+from __future__ import absolute_import
+
+import optparse
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = optparse.OptionParser()
+parser.add_option("--trace", type="string", default="",
+                  help="Branch trace to replay")
+parser.add_option("--bp-type", type="choice", action="append",
+                  choices=ObjectList.bp_list.get_names(),
+                  help="Branch predictor to replay the trace through, "
+                  "may be given more than once")
+parser.add_option("--max-branches", type="int", default=0,
+                  help="Stop after this many branches")
+
+(options, args) = parser.parse_args()
+
+if args:
+    print("Error: script doesn't take any positional arguments")
+    sys.exit(1)
+
+if not options.trace:
+    fatal("A branch trace is needed, use --trace\n")
+
+if not options.bp_type:
+    fatal("No predictors given, use --bp-type\n")
+
+predictors = [ ObjectList.bp_list.get(bp_type)()
+               for bp_type in options.bp_type ]
+
+root = Root(full_system = False,
+            replay = BranchTraceReplay(trace_file = options.trace,
+                                       predictors = predictors,
+                                       max_branches = options.max_branches))
+
+m5.instantiate()
+
+exit_event = m5.simulate()
+print('Exiting @ tick %i because %s' % (m5.curTick(), exit_event.getCause()))
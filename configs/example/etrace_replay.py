@@ -113,6 +113,7 @@ for cpu in system.cpu:
 # Assign input trace files to the Trace CPU
 system.cpu.instTraceFile=options.inst_trace_file
 system.cpu.dataTraceFile=options.data_trace_file
+system.cpu.traceCacheDir=options.trace_cache_dir
 
 # Configure the classic memory system options
 MemClass = Simulation.setMemClass(options)
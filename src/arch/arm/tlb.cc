@@ -267,6 +267,7 @@ TLB::flushAllSecurity(bool secure_lookup, ExceptionLevel target_el,
     }
 
     stats.flushTlb++;
+    countFlush();
 
     // If there's a second stage TLB (and we're not it) then flush it as well
     // if we're currently in hyp mode
@@ -299,6 +300,7 @@ TLB::flushAllNs(ExceptionLevel target_el, bool ignore_el)
     }
 
     stats.flushTlb++;
+    countFlush();
 
     // If there's a second stage TLB (and we're not it) then flush it as well
     if (!isStage2 && !hyp) {
@@ -315,6 +317,7 @@ TLB::flushMvaAsid(Addr mva, uint64_t asn, bool secure_lookup,
             "secure" : "non-secure"));
     _flushMva(mva, asn, secure_lookup, false, target_el, in_host);
     stats.flushTlbMvaAsid++;
+    countFlush();
 }
 
 void
@@ -340,6 +343,7 @@ TLB::flushAsid(uint64_t asn, bool secure_lookup, ExceptionLevel target_el,
         ++x;
     }
     stats.flushTlbAsid++;
+    countFlush();
 }
 
 void
@@ -350,6 +354,7 @@ TLB::flushMva(Addr mva, bool secure_lookup, ExceptionLevel target_el,
             (secure_lookup ? "secure" : "non-secure"));
     _flushMva(mva, 0xbeef, secure_lookup, true, target_el, in_host);
     stats.flushTlbMva++;
+    countFlush();
 }
 
 void
@@ -380,6 +385,7 @@ TLB::flushIpaVmid(Addr ipa, bool secure_lookup, ExceptionLevel target_el)
 {
     assert(!isStage2);
     stage2Tlb->_flushMva(ipa, 0xbeef, secure_lookup, true, target_el, false);
+    countFlush();
 }
 
 void
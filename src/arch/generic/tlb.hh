@@ -50,7 +50,16 @@ class ThreadContext;
 class BaseTLB : public SimObject
 {
   protected:
-    BaseTLB(const Params *p) : SimObject(p) {}
+    BaseTLB(const Params *p) : SimObject(p), _flushCount(0) {}
+
+    /**
+     * Note that translations may have been removed from the TLB. To be
+     * called by every flush and demap operation.
+     */
+    void countFlush() { ++_flushCount; }
+
+  private:
+    uint64_t _flushCount;
 
   public:
 
@@ -137,6 +146,13 @@ class BaseTLB : public SimObject
     virtual Port* getTableWalkerPort() { return NULL; }
 
     void memInvalidate() { flushAll(); }
+
+    /**
+     * Number of flush and demap operations so far. Users that keep a
+     * translation of their own can check it to tell if the translation
+     * may have been removed from the TLB since.
+     */
+    uint64_t flushCount() const { return _flushCount; }
 };
 
 #endif // __ARCH_GENERIC_TLB_HH__
@@ -111,6 +111,8 @@ labelRE = re.compile(r'(?<!%)%\(([^\)]+)\)[sd]')
 class Template(object):
     def __init__(self, parser, t):
         self.parser = parser
+        if parser.simple_exec:
+            t = addSimpleExec(t)
         self.template = t
 
     def subst(self, d):
@@ -269,6 +271,78 @@ class NoFormat(object):
         error(lineno,
               'instruction definition "%s" with no active format!' % name)
 
+###############
+# Simple CPU execute() specialisation
+#
+# When the simple CPUs are built, every execute() method that a template
+# or an output block defines, declares or explicitly instantiates gets an
+# executeSimple() twin next to it. The twin has the same body but takes
+# the (final) SimpleExecContext, so the register and memory accesses of
+# the body are resolved at compile time and can be inlined into it.
+
+execSigRE = re.compile(r'(?:^[ \t]*%\(\w+\)s[ \t]*\n\s*)?'
+                       r'(?:\btemplate\b\s*(?:<[^;{}]*?>)?\s*)?'
+                       r'\bFault\s+(?:[^;{}]*?::)?(?P<name>execute)\s*\('
+                       r'\s*(?P<ctx>ExecContext)\s*\*\s*\w*\s*,'
+                       r'\s*Trace::InstRecord\s*\*\s*\w*\s*\)\s*const\b'
+                       r'(?:\s*override\b)?\s*(?P<end>[;{])',
+                       re.MULTILINE)
+
+# Return the position of the brace closing the one at 'start' in C++
+# code, skipping comments and literals.
+def findClosingBrace(code, start):
+    depth = 0
+    pos = start
+    end = len(code)
+    while pos < end:
+        c = code[pos]
+        if c in '"\'':
+            pos += 1
+            while pos < end and code[pos] != c:
+                pos += 2 if code[pos] == '\\' else 1
+        elif code.startswith('//', pos):
+            pos = code.find('\n', pos)
+            if pos < 0:
+                break
+        elif code.startswith('/*', pos):
+            pos = code.find('*/', pos) + 1
+            if pos <= 0:
+                break
+        elif c == '{':
+            depth += 1
+        elif c == '}':
+            depth -= 1
+            if depth == 0:
+                return pos
+        pos += 1
+    error('unbalanced braces in execute() definition')
+
+# Add the executeSimple() twins to the code of a template or an output
+# block.
+def addSimpleExec(code):
+    pieces = []
+    last = 0
+    for m in execSigRE.finditer(code):
+        if m.start() < last:
+            continue
+        if m.group('end') == '{':
+            end = findClosingBrace(code, m.end() - 1) + 1
+            sep = '\n\n'
+        else:
+            end = m.end()
+            sep = '\n'
+        line_start = code.rfind('\n', 0, m.start()) + 1
+        indent = code[line_start:m.start()]
+        if indent.strip():
+            indent = ''
+        twin = (code[m.start():m.start('name')] + 'executeSimple' +
+                code[m.end('name'):m.start('ctx')] + 'SimpleExecContext' +
+                code[m.end('ctx'):end])
+        pieces += [ code[last:end], sep, indent, twin ]
+        last = end
+    pieces.append(code[last:])
+    return ''.join(pieces)
+
 ###############
 # GenCode class
 #
@@ -1549,10 +1623,13 @@ class LineTracker(object):
 #
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir):
+    def __init__(self, output_dir, simple_exec=False):
         super(ISAParser, self).__init__()
         self.output_dir = output_dir
 
+        # Whether to emit executeSimple() methods for the simple CPUs.
+        self.simple_exec = simple_exec
+
         self.filename = None # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -1717,6 +1794,8 @@ class ISAParser(Grammar):
                 assert(fn in self.files)
                 f.write('#include "%s"\n' % fn)
                 f.write('#include "cpu/exec_context.hh"\n')
+                if self.simple_exec:
+                    f.write('#include "cpu/simple/exec_context.hh"\n')
                 f.write('#include "decoder.hh"\n')
 
                 fn = 'exec-ns.cc.inc'
@@ -2003,7 +2082,10 @@ class ISAParser(Grammar):
 
     def p_output(self, t):
         'output : OUTPUT output_type CODELIT SEMI'
-        kwargs = { t[2]+'_output' : self.process_output(t[3]) }
+        code = t[3]
+        if self.simple_exec:
+            code = addSimpleExec(code)
+        kwargs = { t[2]+'_output' : self.process_output(code) }
         GenCode(self, **kwargs).emit()
 
     def make_split(self):
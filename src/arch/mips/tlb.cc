@@ -185,6 +185,7 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll\n");
+    countFlush();
     memset(table, 0, sizeof(PTE[size]));
     lookupTable.clear();
     nlu = 0;
@@ -184,6 +184,7 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll\n");
+    countFlush();
     memset(table, 0, sizeof(PowerISA::PTE[size]));
     lookupTable.clear();
     nlu = 0;
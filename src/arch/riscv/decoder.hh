@@ -46,7 +46,8 @@ class ISA;
 class Decoder : public InstDecoder
 {
   private:
-    DecodeCache::InstMap<ExtMachInst> instMap;
+    /// Decoded instructions, shared by all the decoders.
+    static DecodeCache::InstMap<ExtMachInst> instMap;
     bool aligned;
     bool mid;
     bool more;
@@ -166,6 +166,7 @@ void
 TLB::demapPage(Addr vpn, uint64_t asid)
 {
     asid &= 0xFFFF;
+    countFlush();
 
     if (vpn == 0 && asid == 0)
         flushAll();
@@ -193,6 +194,7 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll()\n");
+    countFlush();
     for (size_t i = 0; i < size; i++) {
         if (tlb[i].trieHandle)
             remove(i);
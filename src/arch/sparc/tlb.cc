@@ -102,6 +102,7 @@ TLB::insert(Addr va, int partition_id, int context_id, bool real,
     int x;
 
     cacheValid = false;
+    countFlush();
     va &= ~(PTE.size()-1);
 
     DPRINTF(TLB,
@@ -255,6 +256,7 @@ TLB::demapPage(Addr va, int partition_id, bool real, int context_id)
             va, partition_id, context_id, real);
 
     cacheValid = false;
+    countFlush();
 
     // Assemble full address structure
     tr.va = va;
@@ -283,6 +285,7 @@ TLB::demapContext(int partition_id, int context_id)
     DPRINTF(IPR, "TLB: Demapping Context pid=%#d cid=%d\n",
             partition_id, context_id);
     cacheValid = false;
+    countFlush();
     for (int x = 0; x < size; x++) {
         if (tlb[x].range.contextId == context_id &&
             tlb[x].range.partitionId == partition_id) {
@@ -304,6 +307,7 @@ TLB::demapAll(int partition_id)
 {
     DPRINTF(TLB, "TLB: Demapping All pid=%#d\n", partition_id);
     cacheValid = false;
+    countFlush();
     for (int x = 0; x < size; x++) {
         if (tlb[x].valid && !tlb[x].pte.locked() &&
                 tlb[x].range.partitionId == partition_id) {
@@ -322,6 +326,7 @@ void
 TLB::flushAll()
 {
     cacheValid = false;
+    countFlush();
     lookupTable.clear();
 
     for (int x = 0; x < size; x++) {
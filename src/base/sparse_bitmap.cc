@@ -0,0 +1,159 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/sparse_bitmap.hh"
+
+#include <algorithm>
+#include <iterator>
+
+#include "base/bitfield.hh"
+
+SparseBitmap::SparseBitmap()
+    : lastKey(0), lastChunk(nullptr), numValues(0)
+{
+}
+
+SparseBitmap::SparseBitmap(const SparseBitmap &other)
+    : chunks(other.chunks), lastKey(0), lastChunk(nullptr),
+      numValues(other.numValues)
+{
+}
+
+SparseBitmap &
+SparseBitmap::operator=(const SparseBitmap &other)
+{
+    chunks = other.chunks;
+    lastChunk = nullptr;
+    numValues = other.numValues;
+    return *this;
+}
+
+bool
+SparseBitmap::contains(uint64_t value) const
+{
+    auto it = chunks.find(value >> ChunkBits);
+    if (it == chunks.end())
+        return false;
+
+    const Chunk &chunk = it->second;
+    const uint16_t offset = value & ChunkMask;
+    if (chunk.isBitmap())
+        return chunk.bits[offset / 64] & (1ULL << (offset % 64));
+    return std::binary_search(chunk.array.begin(), chunk.array.end(),
+                              offset);
+}
+
+void
+SparseBitmap::clear()
+{
+    chunks.clear();
+    lastChunk = nullptr;
+    numValues = 0;
+}
+
+bool
+SparseBitmap::insertArray(Chunk &chunk, uint16_t offset)
+{
+    auto it = std::lower_bound(chunk.array.begin(), chunk.array.end(),
+                               offset);
+    if (it != chunk.array.end() && *it == offset)
+        return false;
+
+    if (chunk.array.size() < ArrayMax) {
+        chunk.array.insert(it, offset);
+    } else {
+        toBitmap(chunk);
+        chunk.bits[offset / 64] |= 1ULL << (offset % 64);
+    }
+    return true;
+}
+
+void
+SparseBitmap::toBitmap(Chunk &chunk)
+{
+    chunk.bits.assign(BitmapWords, 0);
+    for (auto offset : chunk.array)
+        chunk.bits[offset / 64] |= 1ULL << (offset % 64);
+    chunk.array.clear();
+    chunk.array.shrink_to_fit();
+}
+
+SparseBitmap &
+SparseBitmap::operator|=(const SparseBitmap &other)
+{
+    if (&other == this)
+        return *this;
+
+    for (const auto &key_chunk : other.chunks) {
+        const Chunk &src = key_chunk.second;
+        if (src.count == 0)
+            continue;
+
+        Chunk &dst = chunks[key_chunk.first];
+        numValues -= dst.count;
+
+        if (!dst.isBitmap() && !src.isBitmap()) {
+            std::vector<uint16_t> merged;
+            merged.reserve(dst.array.size() + src.array.size());
+            std::set_union(dst.array.begin(), dst.array.end(),
+                           src.array.begin(), src.array.end(),
+                           std::back_inserter(merged));
+            dst.array.swap(merged);
+            dst.count = dst.array.size();
+            if (dst.array.size() > ArrayMax)
+                toBitmap(dst);
+        } else {
+            if (!dst.isBitmap())
+                toBitmap(dst);
+            if (src.isBitmap()) {
+                for (size_t i = 0; i < BitmapWords; ++i)
+                    dst.bits[i] |= src.bits[i];
+            } else {
+                for (auto offset : src.array)
+                    dst.bits[offset / 64] |= 1ULL << (offset % 64);
+            }
+            dst.count = 0;
+            for (auto word : dst.bits)
+                dst.count += popCount(word);
+        }
+
+        numValues += dst.count;
+    }
+
+    return *this;
+}
+
+uint64_t
+SparseBitmap::memoryUsage() const
+{
+    uint64_t bytes = sizeof(*this);
+    for (const auto &key_chunk : chunks) {
+        const Chunk &chunk = key_chunk.second;
+        bytes += sizeof(key_chunk) + sizeof(void *) * 2 +
+            chunk.array.capacity() * sizeof(uint16_t) +
+            chunk.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
@@ -0,0 +1,164 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPARSE_BITMAP_HH__
+#define __BASE_SPARSE_BITMAP_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A set of 64-bit integers (typically line or page numbers) stored as
+ * a two-level sparse bitmap, in the style of roaring bitmaps. The
+ * values are split into chunks of 2^16 consecutive values. A chunk
+ * with few values holds them as a sorted array of 16-bit offsets, and
+ * is turned into a plain 8 KiB bitmap once the array would take more
+ * space than that. Sparse sets thus cost about two bytes per value,
+ * and dense ones an eighth of a byte, where a hash set of addresses
+ * costs tens of bytes per value.
+ *
+ * The number of values is kept up to date, so reading the cardinality
+ * is free, and sets can be merged chunk by chunk.
+ */
+class SparseBitmap
+{
+  public:
+    SparseBitmap();
+
+    SparseBitmap(const SparseBitmap &other);
+    SparseBitmap &operator=(const SparseBitmap &other);
+
+    /**
+     * Add a value to the set.
+     *
+     * @param value Value to add
+     * @return True if the value was not in the set yet
+     */
+    bool
+    insert(uint64_t value)
+    {
+        Chunk &chunk = getChunk(value >> ChunkBits);
+        const uint16_t offset = value & ChunkMask;
+        bool added;
+        if (chunk.isBitmap()) {
+            uint64_t &word = chunk.bits[offset / 64];
+            const uint64_t bit = 1ULL << (offset % 64);
+            added = !(word & bit);
+            word |= bit;
+        } else {
+            added = insertArray(chunk, offset);
+        }
+        if (added) {
+            ++chunk.count;
+            ++numValues;
+        }
+        return added;
+    }
+
+    /**
+     * Check if a value is in the set.
+     */
+    bool contains(uint64_t value) const;
+
+    /** Number of values in the set. */
+    uint64_t size() const { return numValues; }
+
+    bool empty() const { return numValues == 0; }
+
+    /** Remove all values from the set. */
+    void clear();
+
+    /**
+     * Add all values of another set to this one.
+     */
+    SparseBitmap &operator|=(const SparseBitmap &other);
+
+    /** Approximate number of bytes used to store the values. */
+    uint64_t memoryUsage() const;
+
+  private:
+    /** Number of low bits of a value giving its offset in a chunk */
+    static const unsigned ChunkBits = 16;
+    static const uint64_t ChunkMask = (1ULL << ChunkBits) - 1;
+
+    /** Number of 64-bit words in a bitmap chunk */
+    static const size_t BitmapWords = (1ULL << ChunkBits) / 64;
+
+    /** Largest array chunk, beyond which a bitmap is smaller */
+    static const size_t ArrayMax = BitmapWords * 4;
+
+    struct Chunk
+    {
+        /** Sorted offsets of the values, if this is an array chunk */
+        std::vector<uint16_t> array;
+
+        /** Bits of the values, if this is a bitmap chunk */
+        std::vector<uint64_t> bits;
+
+        /** Number of values in the chunk */
+        uint32_t count = 0;
+
+        bool isBitmap() const { return !bits.empty(); }
+    };
+
+    /**
+     * Get the chunk for a given key, creating it if needed. The last
+     * chunk used is remembered, since accesses tend to be local.
+     */
+    Chunk &
+    getChunk(uint64_t key)
+    {
+        if (lastChunk && lastKey == key)
+            return *lastChunk;
+        lastKey = key;
+        lastChunk = &chunks[key];
+        return *lastChunk;
+    }
+
+    /**
+     * Add an offset to an array chunk, turning it into a bitmap if it
+     * grows too large.
+     *
+     * @return True if the offset was not in the chunk yet
+     */
+    static bool insertArray(Chunk &chunk, uint16_t offset);
+
+    /** Turn an array chunk into a bitmap chunk. */
+    static void toBitmap(Chunk &chunk);
+
+    /** Chunks indexed by the high bits of their values */
+    std::unordered_map<uint64_t, Chunk> chunks;
+
+    /** Key and location of the last chunk used */
+    uint64_t lastKey;
+    Chunk *lastChunk;
+
+    /** Number of values in the set */
+    uint64_t numValues;
+};
+
+#endif // __BASE_SPARSE_BITMAP_HH__
@@ -0,0 +1,120 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_set>
+
+#include "base/sparse_bitmap.hh"
+
+/**
+ * Test that values are only counted once.
+ */
+TEST(SparseBitmapTest, InsertAndContains)
+{
+    SparseBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+
+    ASSERT_TRUE(bitmap.insert(5));
+    ASSERT_TRUE(bitmap.insert(1ULL << 40));
+    ASSERT_FALSE(bitmap.insert(5));
+
+    ASSERT_EQ(bitmap.size(), 2);
+    ASSERT_TRUE(bitmap.contains(5));
+    ASSERT_TRUE(bitmap.contains(1ULL << 40));
+    ASSERT_FALSE(bitmap.contains(6));
+    ASSERT_FALSE(bitmap.contains((1ULL << 40) + 5));
+}
+
+/**
+ * Test that a chunk keeps its values when it turns into a bitmap.
+ */
+TEST(SparseBitmapTest, DenseChunk)
+{
+    SparseBitmap bitmap;
+    for (uint64_t i = 0; i < 65536; i += 3)
+        ASSERT_TRUE(bitmap.insert(i));
+    for (uint64_t i = 0; i < 65536; i += 3)
+        ASSERT_FALSE(bitmap.insert(i));
+
+    ASSERT_EQ(bitmap.size(), 21846);
+    for (uint64_t i = 0; i < 65536; ++i)
+        ASSERT_EQ(bitmap.contains(i), i % 3 == 0);
+}
+
+/**
+ * Test that clearing empties the set and that it can be reused.
+ */
+TEST(SparseBitmapTest, Clear)
+{
+    SparseBitmap bitmap;
+    bitmap.insert(42);
+    bitmap.clear();
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_FALSE(bitmap.contains(42));
+    ASSERT_TRUE(bitmap.insert(42));
+    ASSERT_EQ(bitmap.size(), 1);
+}
+
+/**
+ * Test the union of sets with sparse and dense chunks against a
+ * reference set.
+ */
+TEST(SparseBitmapTest, Union)
+{
+    std::mt19937_64 rng(1);
+    SparseBitmap a, b;
+    std::unordered_set<uint64_t> ref;
+
+    for (int i = 0; i < 20000; ++i) {
+        // A dense region, a sparse region, and values spread widely
+        const uint64_t dense = rng() % 8192;
+        const uint64_t sparse = (1ULL << 20) + rng() % (1ULL << 18);
+        const uint64_t wide = rng() % (1ULL << 48);
+        for (auto value : {dense, sparse, wide}) {
+            ref.insert(value);
+            if (rng() % 2)
+                a.insert(value);
+            else
+                b.insert(value);
+        }
+    }
+
+    const uint64_t a_size = a.size();
+    const uint64_t b_size = b.size();
+
+    SparseBitmap c(a);
+    c |= b;
+    ASSERT_EQ(c.size(), ref.size());
+    for (auto value : ref)
+        ASSERT_TRUE(c.contains(value));
+
+    // The union is idempotent, and leaves the operands untouched
+    c |= a;
+    ASSERT_EQ(c.size(), ref.size());
+    ASSERT_EQ(a.size(), a_size);
+    ASSERT_EQ(b.size(), b_size);
+}
@@ -42,11 +42,12 @@ template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+template<class Value, Addr CacheChunkShift = 12, unsigned FrontShift = 6>
 class AddrMap
 {
   protected:
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
+    static constexpr unsigned FrontEntries = 1U << FrontShift;
 
     static constexpr Addr
     chunkOffset(Addr addr)
@@ -67,60 +68,50 @@ class AddrMap
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // A direct-mapped table of recently used chunks, indexed by the low
+    // bits of the chunk number. The pages holding the hot code of a
+    // program (or of all the cores running it when the map is shared)
+    // rarely conflict in it, so most lookups never reach the hash map.
+    struct FrontEntry
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
-    }
+        Addr chunkAddr;
+        CacheChunk *chunk;
+    };
+    FrontEntry front[FrontEntries];
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the front table, then actually look in the
+    /// hash map.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
-        }
-
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        FrontEntry &entry =
+            front[(chunk_addr >> CacheChunkShift) & (FrontEntries - 1)];
+        if (entry.chunk && entry.chunkAddr == chunk_addr)
+            return entry.chunk;
+
+        // Actually look in the hash_map, adding a new chunk if there is
+        // none for this address yet.
+        CacheChunk *&chunk = chunkMap[chunk_addr];
+        if (!chunk)
+            chunk = new CacheChunk;
+
+        entry.chunkAddr = chunk_addr;
+        entry.chunk = chunk;
+        return chunk;
     }
 
   public:
     /// Constructor
     AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        for (auto &entry : front)
+            entry = { 0, nullptr };
     }
 
     Value &
@@ -47,6 +47,7 @@
 #include <iostream>
 #include <queue>
 #include <sstream>
+#include <utility>
 
 #include "base/logging.hh"
 #include "cpu/activity.hh"
@@ -428,15 +429,34 @@ class Queue : public Named, public Reservable
         if (!BubbleTraits::isBubble(data)) {
             freeReservation();
             queue.push_back(data);
+            checkCapacity();
+        }
+    }
 
-            if (queue.size() > capacity) {
-                warn("%s: No space to push data into queue of capacity"
-                    " %u, pushing anyway\n", name(), capacity);
-            }
+    /** As push(ElemType &) but moves data into the queue rather than
+     *  copying it */
+    void
+    push(ElemType &&data)
+    {
+        if (!BubbleTraits::isBubble(data)) {
+            freeReservation();
+            queue.push_back(std::move(data));
+            checkCapacity();
+        }
+    }
 
+  private:
+    void
+    checkCapacity() const
+    {
+        if (queue.size() > capacity) {
+            warn("%s: No space to push data into queue of capacity"
+                " %u, pushing anyway\n", name(), capacity);
         }
     }
 
+  public:
+
     /** Clear all allocated space.  Be careful how this is used */
     void clearReservedSpace() { numReservedSlots = 0; }
 
@@ -571,6 +591,18 @@ class InputBuffer : public Reservable
     /** Pointer to the single element (if not NULL) */
     mutable ElemType *elementPtr;
 
+    /** Move an element out of the latch it arrived on and into the queue.
+     *  The latch slot is only reported again by MinorTrace, so keep it
+     *  intact by copying when tracing */
+    void
+    pushElement(ElemType &element) const
+    {
+        if (DTRACE(MinorTrace))
+            queue.push(element);
+        else
+            queue.push(std::move(element));
+    }
+
   public:
     InputBuffer(const std::string &name, const std::string &data_name,
         unsigned int capacity_) :
@@ -590,7 +622,7 @@ class InputBuffer : public Reservable
             if (queue.empty())
                 elementPtr = &new_element;
             else
-                queue.push(new_element);
+                pushElement(new_element);
         }
     }
 
@@ -625,7 +657,7 @@ class InputBuffer : public Reservable
     pushTail() const
     {
         if (elementPtr)
-            queue.push(*elementPtr);
+            pushElement(*elementPtr);
         elementPtr = NULL;
     }
 
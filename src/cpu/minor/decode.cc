@@ -332,6 +332,20 @@ Decode::isDrained()
     return (*inp.outputWire).isBubble();
 }
 
+bool
+Decode::isIdle() const
+{
+    if (!inp.outputWire->isBubble())
+        return false;
+
+    for (const auto &buffer : inputBuffer) {
+        if (!buffer.empty())
+            return false;
+    }
+
+    return true;
+}
+
 void
 Decode::minorTrace() const
 {
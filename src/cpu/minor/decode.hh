@@ -154,6 +154,10 @@ class Decode : public Named
      *  into Decode and on to Execute which is responsible for
      *  actually killing instructions */
     bool isDrained();
+
+    /** Does this stage have no input, either newly arrived or buffered?
+     *  An idle Decode produces no output and so need not be evaluated */
+    bool isIdle() const;
 };
 
 }
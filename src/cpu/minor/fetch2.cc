@@ -602,6 +602,20 @@ Fetch2::isDrained()
            (*predictionOut.inputWire).isBubble();
 }
 
+bool
+Fetch2::isIdle() const
+{
+    if (!inp.outputWire->isBubble() || !branchInp.outputWire->isBubble())
+        return false;
+
+    for (const auto &buffer : inputBuffer) {
+        if (!buffer.empty())
+            return false;
+    }
+
+    return true;
+}
+
 Fetch2::Fetch2Stats::Fetch2Stats(MinorCPU *cpu)
       : Stats::Group(cpu, "fetch2"),
       ADD_STAT(intInstructions,
@@ -221,6 +221,11 @@ class Fetch2 : public Named
      *  Execute halting Fetch1 causing Fetch2 to naturally drain.
      *  Branch predictions are ignored by Fetch1 during halt */
     bool isDrained();
+
+    /** Does this stage have no lines to work on and no branch from
+     *  Execute to act upon?  An idle Fetch2 produces neither output nor
+     *  predictions and so need not be evaluated */
+    bool isIdle() const;
 };
 
 }
@@ -268,6 +268,10 @@ class ForwardInstData /* : public ReportIF, public BubbleIF */
 
     ForwardInstData(const ForwardInstData &src);
 
+    /** Take over src's insts without touching their reference counts,
+     *  leaving src as an empty bubble */
+    ForwardInstData(ForwardInstData &&src);
+
   public:
     /** Number of instructions carried by this object */
     unsigned int width() const { return numInsts; }
@@ -275,6 +279,10 @@ class ForwardInstData /* : public ReportIF, public BubbleIF */
     /** Copy the inst array only as far as numInsts */
     ForwardInstData &operator =(const ForwardInstData &src);
 
+    /** Move the inst array only as far as numInsts, leaving src as an
+     *  empty bubble */
+    ForwardInstData &operator =(ForwardInstData &&src);
+
     /** Resize a bubble/empty ForwardInstData and fill with bubbles */
     void resize(unsigned int width);
 
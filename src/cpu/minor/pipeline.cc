@@ -55,6 +55,7 @@ Pipeline::Pipeline(MinorCPU &cpu_, MinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    skipIdleStages(cpu_.threadPolicy != Enums::Random),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -125,8 +126,16 @@ Pipeline::evaluate()
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
     execute.evaluate();
-    decode.evaluate();
-    fetch2.evaluate();
+
+    /* Decode and Fetch2 do nothing but refresh their blocked flags in a
+     *  cycle with no input.  Those flags are only ever looked at by
+     *  MinorTrace, so idle stages can be skipped unless tracing */
+    bool skip_idle = skipIdleStages && !DTRACE(MinorTrace);
+
+    if (!skip_idle || !decode.isIdle())
+        decode.evaluate();
+    if (!skip_idle || !fetch2.isIdle())
+        fetch2.evaluate();
     fetch1.evaluate();
 
     if (DTRACE(MinorTrace))
@@ -74,6 +74,11 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Allow Fetch2 and Decode to be skipped in cycles in which they have
+     *  no input.  Not possible with the Random thread policy as each
+     *  evaluation of a stage draws from the random number stream */
+    bool skipIdleStages;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -46,6 +46,7 @@
 #include "base/statistics.hh"
 #include "cpu/exetrace.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/thread_priority_list.hh"
 #include "cpu/timebuf.hh"
 #include "enums/CommitPolicy.hh"
 #include "sim/probe/probe.hh"
@@ -390,7 +391,7 @@ class DefaultCommit
     DynInstPtr squashAfterInst[Impl::MaxThreads];
 
     /** Priority List used for Commit Policy */
-    std::list<ThreadID> priority_list;
+    ThreadPriorityList<Impl::MaxThreads> priority_list;
 
     /** IEW to Commit delay. */
     const Cycles iewToCommitDelay;
@@ -428,12 +428,7 @@ template <class Impl>
 void
 DefaultCommit<Impl>::deactivateThread(ThreadID tid)
 {
-    list<ThreadID>::iterator thread_it = std::find(priority_list.begin(),
-            priority_list.end(), tid);
-
-    if (thread_it != priority_list.end()) {
-        priority_list.erase(thread_it);
-    }
+    priority_list.remove(tid);
 }
 
 template <class Impl>
@@ -1533,28 +1528,12 @@ template<class Impl>
 ThreadID
 DefaultCommit<Impl>::roundRobin()
 {
-    list<ThreadID>::iterator pri_iter = priority_list.begin();
-    list<ThreadID>::iterator end      = priority_list.end();
-
-    while (pri_iter != end) {
-        ThreadID tid = *pri_iter;
-
-        if (commitStatus[tid] == Running ||
-            commitStatus[tid] == Idle ||
-            commitStatus[tid] == FetchTrapPending) {
-
-            if (rob->isHeadReady(tid)) {
-                priority_list.erase(pri_iter);
-                priority_list.push_back(tid);
-
-                return tid;
-            }
-        }
-
-        pri_iter++;
-    }
-
-    return InvalidThreadID;
+    return priority_list.select([this](ThreadID tid) {
+        return (commitStatus[tid] == Running ||
+                commitStatus[tid] == Idle ||
+                commitStatus[tid] == FetchTrapPending) &&
+            rob->isHeadReady(tid);
+    });
 }
 
 template<class Impl>
@@ -87,6 +87,11 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
                 false, Event::CPU_Tick_Pri),
       threadExitEvent([this]{ exitThreads(); }, "FullO3CPU exit threads",
                 false, Event::CPU_Exit_Pri),
+      // Enough instructions for a full ROB plus the fetch queues and a
+      // cycle's worth in decode and rename.
+      dynInstPool(params->numROBEntries +
+                  params->numThreads * params->fetchQueueSize +
+                  params->decodeWidth + params->renameWidth),
 #ifndef NDEBUG
       instcount(0),
 #endif
@@ -55,6 +55,7 @@
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/cpu_policy.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
@@ -531,6 +532,12 @@ class FullO3CPU : public BaseO3CPU
     void dumpInsts();
 
   public:
+    /** Recycled storage for the dynamic instructions built by fetch. It
+     * is declared ahead of every structure holding instructions so that
+     * it is destroyed after all of them.
+     */
+    DynInstPool dynInstPool;
+
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
     int instcount;
@@ -46,6 +46,7 @@
 
 #include "config/the_isa.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/isa_specific.hh"
 #include "cpu/base_dyn_inst.hh"
 #include "cpu/inst_seq.hh"
@@ -85,6 +86,28 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /** Allocates the instruction from its CPU's recycling pool. */
+    static void *
+    operator new(size_t count, DynInstPool &pool)
+    {
+        return pool.allocate(count);
+    }
+
+    /** Instructions created outside of a CPU's fetch are not pooled. */
+    static void *
+    operator new(size_t count)
+    {
+        return DynInstPool::allocateUnpooled(count);
+    }
+
+    static void operator delete(void *ptr) { DynInstPool::deallocate(ptr); }
+
+    static void
+    operator delete(void *ptr, DynInstPool &pool)
+    {
+        DynInstPool::deallocate(ptr);
+    }
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -118,6 +141,9 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
 
   public:
+    /** Slot held in the IQ's issue matrix, -1 if none. */
+    int iqSlot;
+
 #if TRACING_ON
     /** Tick records used for the pipeline activity viewer. */
     Tick fetchTick;      // instruction fetch is completed.
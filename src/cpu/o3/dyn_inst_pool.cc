@@ -0,0 +1,108 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <cassert>
+#include <new>
+
+#include "base/logging.hh"
+
+DynInstPool::DynInstPool(size_t num_blocks)
+    : blockSize(0), blocksPerChunk(num_blocks), freeList(nullptr),
+      numInUse(0)
+{
+    assert(blocksPerChunk > 0);
+}
+
+DynInstPool::~DynInstPool()
+{
+    if (numInUse)
+        warn("%d dynamic instructions outlived their pool.\n", numInUse);
+}
+
+void
+DynInstPool::grow()
+{
+    assert(blockSize);
+    chunks.emplace_back(new char[blockSize * blocksPerChunk]);
+    char *chunk = chunks.back().get();
+    for (size_t i = 0; i < blocksPerChunk; ++i) {
+        Header *block = reinterpret_cast<Header *>(chunk + i * blockSize);
+        block->pool = this;
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+void *
+DynInstPool::allocate(size_t size)
+{
+    if (!blockSize) {
+        // All the instructions of a CPU have the same type, so the first
+        // request determines the block size.
+        blockSize = sizeof(Header) +
+            (size + alignof(Header) - 1) / alignof(Header) * alignof(Header);
+    }
+    panic_if(sizeof(Header) + size > blockSize,
+             "Dynamic instruction of %d bytes does not fit its pool.\n",
+             size);
+
+    if (!freeList)
+        grow();
+
+    Header *block = freeList;
+    freeList = block->next;
+    ++numInUse;
+    return block + 1;
+}
+
+void *
+DynInstPool::allocateUnpooled(size_t size)
+{
+    Header *block =
+        static_cast<Header *>(::operator new(sizeof(Header) + size));
+    block->pool = nullptr;
+    return block + 1;
+}
+
+void
+DynInstPool::deallocate(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    Header *block = static_cast<Header *>(ptr) - 1;
+    DynInstPool *pool = block->pool;
+    if (!pool) {
+        ::operator delete(block);
+        return;
+    }
+
+    assert(pool->numInUse > 0);
+    --pool->numInUse;
+    block->next = pool->freeList;
+    pool->freeList = block;
+}
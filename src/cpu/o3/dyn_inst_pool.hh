@@ -0,0 +1,96 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Recycling allocator for the dynamic instructions of one O3 CPU.
+ *
+ * Every fetched micro-op gets a DynInst, and most of them (including
+ * all the wrong-path instructions squashed after a misprediction) are
+ * freed a few cycles later. Instead of going through the global
+ * allocator each time, freed instructions are kept on a free list and
+ * handed out again. Storage is carved out of large chunks, the first of
+ * which is sized for the number of instructions the CPU can have in
+ * flight; further chunks are only added if that estimate is exceeded.
+ *
+ * Every block is prefixed with a small header recording the pool it
+ * came from so that the DynInst's class-specific operator delete can
+ * return it to the right pool. The pool must therefore outlive all the
+ * instructions allocated from it.
+ */
+class DynInstPool
+{
+  public:
+    /**
+     * @param num_blocks Number of instructions to make room for in each
+     *                   chunk of storage.
+     */
+    explicit DynInstPool(size_t num_blocks);
+    ~DynInstPool();
+
+    /** Allocate storage for an instruction of the given size. */
+    void *allocate(size_t size);
+
+    /** Return storage obtained through allocate() to its pool. */
+    static void deallocate(void *ptr);
+
+    /**
+     * Allocate storage for an instruction that does not belong to any
+     * pool; deallocate() hands it back to the global allocator.
+     */
+    static void *allocateUnpooled(size_t size);
+
+    /** Number of blocks currently handed out. */
+    size_t inUse() const { return numInUse; }
+
+  private:
+    struct alignas(std::max_align_t) Header
+    {
+        /** Owning pool, or nullptr for unpooled storage. */
+        DynInstPool *pool;
+        /** Next free block while on the free list. */
+        Header *next;
+    };
+
+    /** Add a chunk of storage and thread its blocks on the free list. */
+    void grow();
+
+    /** Size of the blocks, including the header, set on first use. */
+    size_t blockSize;
+    /** Number of blocks per chunk. */
+    const size_t blocksPerChunk;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    Header *freeList;
+    size_t numInUse;
+};
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
@@ -46,6 +46,7 @@
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/pc_event.hh"
+#include "cpu/o3/thread_priority_list.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "cpu/timebuf.hh"
 #include "cpu/translation.hh"
@@ -208,7 +209,7 @@ class DefaultFetch
     FetchPolicy fetchPolicy;
 
     /** List that has the threads organized by priority. */
-    std::list<ThreadID> priorityList;
+    ThreadPriorityList<Impl::MaxThreads> priorityList;
 
     /** Probe points. */
     ProbePointArg<DynInstPtr> *ppFetch;
@@ -389,6 +390,21 @@ class DefaultFetch
     /** Returns the appropriate thread to fetch using a round robin policy. */
     ThreadID roundRobin();
 
+    /** Returns whether a thread's status allows it to be picked to fetch
+     * by the SMT fetch policies. */
+    bool
+    canFetch(ThreadID tid) const
+    {
+        return fetchStatus[tid] == Running ||
+               fetchStatus[tid] == IcacheAccessComplete ||
+               fetchStatus[tid] == Idle;
+    }
+
+    /** Returns the active thread that can fetch and has the lowest
+     * count of instructions in the given IEW structure. */
+    ThreadID
+    fewestInsts(unsigned TimeStruct::iewComm::*count);
+
     /** Returns the appropriate thread to fetch using the IQ count policy. */
     ThreadID iqCount();
 
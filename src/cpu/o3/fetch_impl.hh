@@ -512,10 +512,7 @@ void
 DefaultFetch<Impl>::deactivateThread(ThreadID tid)
 {
     // Update priority list
-    auto thread_it = std::find(priorityList.begin(), priorityList.end(), tid);
-    if (thread_it != priorityList.end()) {
-        priorityList.erase(thread_it);
-    }
+    priorityList.remove(tid);
 }
 
 template <class Impl>
@@ -1075,7 +1072,8 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction =
-        new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
+        new (cpu->dynInstPool) DynInst(staticInst, curMacroop, thisPC,
+                                       nextPC, seq, cpu);
     instruction->setTid(tid);
 
     instruction->setThreadState(cpu->thread[tid]);
@@ -1434,9 +1432,7 @@ DefaultFetch<Impl>::getFetchingThread()
 
         ThreadID tid = *thread;
 
-        if (fetchStatus[tid] == Running ||
-            fetchStatus[tid] == IcacheAccessComplete ||
-            fetchStatus[tid] == Idle) {
+        if (canFetch(tid)) {
             return tid;
         } else {
             return InvalidThreadID;
@@ -1449,103 +1445,47 @@ template<class Impl>
 ThreadID
 DefaultFetch<Impl>::roundRobin()
 {
-    list<ThreadID>::iterator pri_iter = priorityList.begin();
-    list<ThreadID>::iterator end      = priorityList.end();
-
-    ThreadID high_pri;
-
-    while (pri_iter != end) {
-        high_pri = *pri_iter;
-
-        assert(high_pri <= numThreads);
-
-        if (fetchStatus[high_pri] == Running ||
-            fetchStatus[high_pri] == IcacheAccessComplete ||
-            fetchStatus[high_pri] == Idle) {
-
-            priorityList.erase(pri_iter);
-            priorityList.push_back(high_pri);
+    return priorityList.select([this](ThreadID tid) {
+        return canFetch(tid);
+    });
+}
 
-            return high_pri;
+template<class Impl>
+ThreadID
+DefaultFetch<Impl>::fewestInsts(unsigned TimeStruct::iewComm::*count)
+{
+    // A linear scan is cheaper than sorting for the handful of threads an
+    // SMT core has. Ties go to the thread that comes first in the active
+    // thread list.
+    ThreadID fewest_tid = InvalidThreadID;
+    unsigned fewest = 0;
+
+    for (ThreadID tid : *activeThreads) {
+        if (!canFetch(tid))
+            continue;
+
+        const unsigned insts = fromIEW->iewInfo[tid].*count;
+        if (fewest_tid == InvalidThreadID || insts < fewest) {
+            fewest_tid = tid;
+            fewest = insts;
         }
-
-        pri_iter++;
     }
 
-    return InvalidThreadID;
+    return fewest_tid;
 }
 
 template<class Impl>
 ThreadID
 DefaultFetch<Impl>::iqCount()
 {
-    //sorted from lowest->highest
-    std::priority_queue<unsigned,vector<unsigned>,
-                        std::greater<unsigned> > PQ;
-    std::map<unsigned, ThreadID> threadMap;
-
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
-
-    while (threads != end) {
-        ThreadID tid = *threads++;
-        unsigned iqCount = fromIEW->iewInfo[tid].iqCount;
-
-        //we can potentially get tid collisions if two threads
-        //have the same iqCount, but this should be rare.
-        PQ.push(iqCount);
-        threadMap[iqCount] = tid;
-    }
-
-    while (!PQ.empty()) {
-        ThreadID high_pri = threadMap[PQ.top()];
-
-        if (fetchStatus[high_pri] == Running ||
-            fetchStatus[high_pri] == IcacheAccessComplete ||
-            fetchStatus[high_pri] == Idle)
-            return high_pri;
-        else
-            PQ.pop();
-
-    }
-
-    return InvalidThreadID;
+    return fewestInsts(&TimeStruct::iewComm::iqCount);
 }
 
 template<class Impl>
 ThreadID
 DefaultFetch<Impl>::lsqCount()
 {
-    //sorted from lowest->highest
-    std::priority_queue<unsigned,vector<unsigned>,
-                        std::greater<unsigned> > PQ;
-    std::map<unsigned, ThreadID> threadMap;
-
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
-
-    while (threads != end) {
-        ThreadID tid = *threads++;
-        unsigned ldstqCount = fromIEW->iewInfo[tid].ldstqCount;
-
-        //we can potentially get tid collisions if two threads
-        //have the same iqCount, but this should be rare.
-        PQ.push(ldstqCount);
-        threadMap[ldstqCount] = tid;
-    }
-
-    while (!PQ.empty()) {
-        ThreadID high_pri = threadMap[PQ.top()];
-
-        if (fetchStatus[high_pri] == Running ||
-            fetchStatus[high_pri] == IcacheAccessComplete ||
-            fetchStatus[high_pri] == Idle)
-            return high_pri;
-        else
-            PQ.pop();
-    }
-
-    return InvalidThreadID;
+    return fewestInsts(&TimeStruct::iewComm::ldstqCount);
 }
 
 template<class Impl>
@@ -47,12 +47,15 @@
 #include <queue>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/issue_matrix.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQScheduler.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -307,8 +310,12 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued),
+     * oldest first, one per thread. Instructions stay on it until the IQ
+     * learns that they committed, so it holds a ROB's worth of instructions
+     * plus those committed during the commit to IEW delay.
+     */
+    std::vector<CircularQueue<DynInstPtr>> instList;
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -395,6 +402,42 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Ready and age tracking over the IQ entries, replacing the ready
+     *  queues and the age order list when the matrix scheduler is used.
+     */
+    IssueMatrix issueMatrix;
+
+    /** Instruction held in each slot of the issue matrix. */
+    std::vector<DynInstPtr> slotInsts;
+
+    /** Gives an instruction a slot in the issue matrix, if it is used. */
+    void allocateSlot(const DynInstPtr &inst);
+
+    /** Releases an instruction's slot in the issue matrix, if it has one. */
+    void freeSlot(const DynInstPtr &inst);
+
+    /** Puts an instruction that is ready to issue on the ready queues,
+     *  or marks it ready in the issue matrix.
+     */
+    void markReady(const DynInstPtr &inst);
+
+    /**
+     * Tries to get a FU for a ready instruction and issue it.
+     * @return Whether the instruction was issued.
+     */
+    bool issueInst(const DynInstPtr &issuing_inst, OpClass op_class,
+                   IssueStruct *i2e_info);
+
+    /** Selects and issues ready instructions in age order using the
+     *  ready queues and the age order list.
+     */
+    int scheduleFromList(IssueStruct *i2e_info);
+
+    /** Selects and issues ready instructions in age order using the
+     *  issue matrix.
+     */
+    int scheduleFromMatrix(IssueStruct *i2e_info);
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
@@ -402,6 +445,9 @@ class InstructionQueue
     /** IQ sharing policy for SMT. */
     SMTQueuePolicy iqPolicy;
 
+    /** Wakeup/select implementation. */
+    IQScheduler iqScheduler;
+
     /** Number of Total Threads*/
     ThreadID numThreads;
 
@@ -87,7 +87,13 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params->fuPool),
+      instList(Impl::MaxThreads, CircularQueue<DynInstPtr>(
+          params->numROBEntries +
+          params->commitToIEWDelay * params->commitWidth)),
+      issueMatrix(params->numIQEntries),
+      slotInsts(params->numIQEntries),
       iqPolicy(params->smtIQPolicy),
+      iqScheduler(params->iqScheduler),
       numEntries(params->numIQEntries),
       totalWidth(params->issueWidth),
       commitToIEWDelay(params->commitToIEWDelay)
@@ -396,7 +402,10 @@ InstructionQueue<Impl>::resetState()
     //Initialize thread IQ counts
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
         count[tid] = 0;
-        instList[tid].clear();
+        while (!instList[tid].empty()) {
+            instList[tid].front() = nullptr;
+            instList[tid].pop_front();
+        }
     }
 
     // Initialize the number of free IQ entries.
@@ -421,6 +430,14 @@ InstructionQueue<Impl>::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    for (auto &slot_inst : slotInsts) {
+        if (slot_inst) {
+            slot_inst->iqSlot = -1;
+            slot_inst = nullptr;
+        }
+    }
+    issueMatrix.reset();
+
     nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
@@ -559,6 +576,10 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
+    if (iqScheduler == IQScheduler::Matrix) {
+        return issueMatrix.anyReady();
+    }
+
     if (!listOrder.empty()) {
         return true;
     }
@@ -591,11 +612,15 @@ InstructionQueue<Impl>::insert(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
+    panic_if(instList[new_inst->threadNumber].full(),
+             "IQ instruction list of thread %i is full.",
+             new_inst->threadNumber);
     instList[new_inst->threadNumber].push_back(new_inst);
 
     --freeEntries;
 
     new_inst->setInIQ();
+    allocateSlot(new_inst);
 
     // Look through its source registers (physical regs), and mark any
     // dependencies.
@@ -642,11 +667,15 @@ InstructionQueue<Impl>::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
+    panic_if(instList[new_inst->threadNumber].full(),
+             "IQ instruction list of thread %i is full.",
+             new_inst->threadNumber);
     instList[new_inst->threadNumber].push_back(new_inst);
 
     --freeEntries;
 
     new_inst->setInIQ();
+    allocateSlot(new_inst);
 
     // Have this instruction set itself as the producer of its destination
     // register(s).
@@ -787,6 +816,31 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
+    int total_issued;
+    if (iqScheduler == IQScheduler::Matrix) {
+        total_issued = scheduleFromMatrix(i2e_info);
+    } else {
+        total_issued = scheduleFromList(i2e_info);
+    }
+
+    numIssuedDist.sample(total_issued);
+    iqInstsIssued+= total_issued;
+
+    // If we issued any instructions, tell the CPU we had activity.
+    // @todo If the way deferred memory instructions are handeled due to
+    // translation changes then the deferredMemInsts condition should be removed
+    // from the code below.
+    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
+        cpu->activityThisCycle();
+    } else {
+        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+    }
+}
+
+template <class Impl>
+int
+InstructionQueue<Impl>::scheduleFromList(IssueStruct *i2e_info)
+{
     // Have iterator to head of the list
     // While I haven't exceeded bandwidth or reached the end of the list,
     // Try to get a FU that can do what this op needs.
@@ -833,60 +887,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                vecAluAccesses++;
-            } else {
-                intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueInst(issuing_inst, op_class, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -896,44 +897,143 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            statIssuedInstType[tid][op_class]++;
         } else {
-            statFuBusy[op_class]++;
-            fuBusy[tid]++;
             ++order_it;
         }
     }
 
-    numIssuedDist.sample(total_issued);
-    iqInstsIssued+= total_issued;
+    return total_issued;
+}
 
-    // If we issued any instructions, tell the CPU we had activity.
-    // @todo If the way deferred memory instructions are handeled due to
-    // translation changes then the deferredMemInsts condition should be removed
-    // from the code below.
-    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
-        cpu->activityThisCycle();
+template <class Impl>
+int
+InstructionQueue<Impl>::scheduleFromMatrix(IssueStruct *i2e_info)
+{
+    // Squashed instructions are dropped from the matrix when they are
+    // squashed, so every candidate can be issued if a FU is free. Once
+    // an op class fails to get a FU, none of its instructions are
+    // considered again this cycle.
+    int total_issued = 0;
+
+    issueMatrix.beginSelect();
+
+    while (total_issued < totalWidth) {
+        const int slot = issueMatrix.selectOldest();
+        if (slot == IssueMatrix::NoSlot)
+            break;
+
+        DynInstPtr issuing_inst = slotInsts[slot];
+        OpClass op_class = issueMatrix.opClass(slot);
+
+        if (issuing_inst->isFloating()) {
+            fpInstQueueReads++;
+        } else if (issuing_inst->isVector()) {
+            vecInstQueueReads++;
+        } else {
+            intInstQueueReads++;
+        }
+
+        if (issueInst(issuing_inst, op_class, i2e_info)) {
+            // Memory instructions keep their slot until they complete.
+            if (issuing_inst->iqSlot == slot)
+                issueMatrix.clearReady(slot);
+
+            ++total_issued;
+        } else {
+            issueMatrix.excludeOpClass(op_class);
+        }
+    }
+
+    return total_issued;
+}
+
+template <class Impl>
+bool
+InstructionQueue<Impl>::issueInst(const DynInstPtr &issuing_inst,
+                                  OpClass op_class, IssueStruct *i2e_info)
+{
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            vecAluAccesses++;
+        } else {
+            intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == FUPool::NoFreeFU) {
+        statFuBusy[op_class]++;
+        fuBusy[tid]++;
+        return false;
+    }
+
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
     } else {
-        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
+    }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+        freeSlot(issuing_inst);
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
     }
+
+    statIssuedInstType[tid][op_class]++;
+
+    return true;
 }
 
 template <class Impl>
@@ -971,11 +1071,9 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
+        instList[tid].front() = nullptr;
         instList[tid].pop_front();
     }
 
@@ -1014,6 +1112,7 @@ InstructionQueue<Impl>::wakeDependents(const DynInstPtr &completed_inst)
         ++freeEntries;
         completed_inst->memOpDone(true);
         count[tid]--;
+        freeSlot(completed_inst);
     } else if (completed_inst->isMemBarrier() ||
                completed_inst->isWriteBarrier()) {
         // Completes a non mem ref barrier
@@ -1086,23 +1185,7 @@ template <class Impl>
 void
 InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
 {
-    OpClass op_class = ready_inst->opClass();
-
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
-
-    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
-            "the ready list, PC %s opclass:%i [sn:%llu].\n",
-            ready_inst->pcState(), op_class, ready_inst->seqNum);
+    markReady(ready_inst);
 }
 
 template <class Impl>
@@ -1209,19 +1292,15 @@ template <class Impl>
 void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = std::move(instList[tid].back());
         if (squashed_inst->isFloating()) {
             fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1234,7 +1313,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
+            instList[tid].pop_back();
             continue;
         }
 
@@ -1322,6 +1401,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             count[squashed_inst->threadNumber]--;
 
             ++freeEntries;
+            freeSlot(squashed_inst);
         }
 
         // IQ clears out the heads of the dependency graph only when
@@ -1343,7 +1423,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
         ++iqSquashedInstsExamined;
     }
 }
@@ -1452,26 +1532,75 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
             return;
         }
 
-        OpClass op_class = inst->opClass();
+        markReady(inst);
+    }
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::markReady(const DynInstPtr &inst)
+{
+    OpClass op_class = inst->opClass();
+
+    if (iqScheduler == IQScheduler::Matrix) {
+        // Squashed instructions have already left the matrix, but
+        // deferred or blocked memory instructions can still come back
+        // after being squashed.
+        if (inst->iqSlot == -1) {
+            assert(inst->isSquashed());
+            ++iqSquashedInstsIssued;
+            return;
+        }
+
+        DPRINTF(IQ, "Instruction is ready to issue, marking slot %i "
+                "ready, PC %s opclass:%i [sn:%llu].\n",
+                inst->iqSlot, inst->pcState(), op_class, inst->seqNum);
+
+        issueMatrix.setReady(inst->iqSlot, op_class);
+        return;
+    }
 
-        DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
-                "the ready list, PC %s opclass:%i [sn:%llu].\n",
-                inst->pcState(), op_class, inst->seqNum);
+    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
+            "the ready list, PC %s opclass:%i [sn:%llu].\n",
+            inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+    readyInsts[op_class].push(inst);
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
     }
 }
 
+template <class Impl>
+void
+InstructionQueue<Impl>::allocateSlot(const DynInstPtr &inst)
+{
+    if (iqScheduler != IQScheduler::Matrix)
+        return;
+
+    assert(inst->iqSlot == -1);
+    inst->iqSlot = issueMatrix.allocate();
+    slotInsts[inst->iqSlot] = inst;
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::freeSlot(const DynInstPtr &inst)
+{
+    if (inst->iqSlot == -1)
+        return;
+
+    issueMatrix.free(inst->iqSlot);
+    slotInsts[inst->iqSlot] = nullptr;
+    inst->iqSlot = -1;
+}
+
 template <class Impl>
 int
 InstructionQueue<Impl>::countInsts()
@@ -1483,6 +1612,10 @@ template <class Impl>
 void
 InstructionQueue<Impl>::dumpLists()
 {
+    if (iqScheduler == IQScheduler::Matrix) {
+        cprintf("Ready instructions: %i\n", issueMatrix.numReady());
+    }
+
     for (int i = 0; i < Num_OpClasses; ++i) {
         cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
 
@@ -1529,7 +1662,7 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        auto inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -0,0 +1,170 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/issue_matrix.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+
+IssueMatrix::IssueMatrix(unsigned num_slots)
+    : numWords((num_slots + WordBits - 1) / WordBits),
+      valid(numWords), ready(numWords), candidates(numWords),
+      older(num_slots * numWords), slotClass(num_slots, No_OpClass)
+{
+    assert(num_slots > 0);
+    for (auto &class_ready : classReady)
+        class_ready.resize(numWords);
+    freeSlots.reserve(num_slots);
+    reset();
+}
+
+void
+IssueMatrix::reset()
+{
+    std::fill(valid.begin(), valid.end(), 0);
+    std::fill(ready.begin(), ready.end(), 0);
+    std::fill(candidates.begin(), candidates.end(), 0);
+    std::fill(older.begin(), older.end(), 0);
+    for (auto &class_ready : classReady)
+        std::fill(class_ready.begin(), class_ready.end(), 0);
+
+    // Hand out the low slots first so that a lightly loaded IQ only
+    // touches the first words of each vector.
+    freeSlots.clear();
+    for (int slot = numSlots() - 1; slot >= 0; --slot)
+        freeSlots.push_back(slot);
+}
+
+int
+IssueMatrix::allocate()
+{
+    assert(!freeSlots.empty());
+    const int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    // Everything already in the matrix is older than the new instruction.
+    std::copy(valid.begin(), valid.end(), olderRow(slot));
+    setBit(valid, slot);
+
+    return slot;
+}
+
+void
+IssueMatrix::free(int slot)
+{
+    assert(testBit(valid, slot));
+
+    if (isReady(slot))
+        clearReady(slot);
+    clearBit(candidates, slot);
+    clearBit(valid, slot);
+
+    // Clear the slot's column so that its next occupant does not appear
+    // older than the instructions that are still in the matrix.
+    const unsigned word = slot / WordBits;
+    const Word mask = ~(Word(1) << (slot % WordBits));
+    for (unsigned row = 0; row < numSlots(); ++row)
+        older[row * numWords + word] &= mask;
+
+    freeSlots.push_back(slot);
+}
+
+void
+IssueMatrix::setReady(int slot, OpClass op_class)
+{
+    assert(testBit(valid, slot));
+    assert(!isReady(slot));
+
+    slotClass[slot] = op_class;
+    setBit(ready, slot);
+    setBit(classReady[op_class], slot);
+}
+
+void
+IssueMatrix::clearReady(int slot)
+{
+    clearBit(ready, slot);
+    clearBit(classReady[slotClass[slot]], slot);
+}
+
+bool
+IssueMatrix::anyReady() const
+{
+    Word any = 0;
+    for (unsigned i = 0; i < numWords; ++i)
+        any |= ready[i];
+    return any != 0;
+}
+
+unsigned
+IssueMatrix::numReady() const
+{
+    unsigned num = 0;
+    for (unsigned i = 0; i < numWords; ++i)
+        num += popCount(ready[i]);
+    return num;
+}
+
+void
+IssueMatrix::beginSelect()
+{
+    std::copy(ready.begin(), ready.end(), candidates.begin());
+}
+
+int
+IssueMatrix::selectOldest()
+{
+    for (unsigned word = 0; word < numWords; ++word) {
+        Word bits = candidates[word];
+        while (bits) {
+            const int slot = word * WordBits + ctz64(bits);
+            bits &= bits - 1;
+
+            // The oldest candidate is the one no other candidate is
+            // older than.
+            const Word *row = olderRow(slot);
+            Word conflicts = 0;
+            for (unsigned i = 0; i < numWords; ++i)
+                conflicts |= row[i] & candidates[i];
+
+            if (!conflicts) {
+                clearBit(candidates, slot);
+                return slot;
+            }
+        }
+    }
+
+    return NoSlot;
+}
+
+void
+IssueMatrix::excludeOpClass(OpClass op_class)
+{
+    const std::vector<Word> &class_ready = classReady[op_class];
+    for (unsigned i = 0; i < numWords; ++i)
+        candidates[i] &= ~class_ready[i];
+}
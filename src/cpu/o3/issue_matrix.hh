@@ -0,0 +1,168 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_ISSUE_MATRIX_HH__
+#define __CPU_O3_ISSUE_MATRIX_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu/op_class.hh"
+
+/**
+ * Bit-matrix select logic for the instruction queue.
+ *
+ * Every instruction in the IQ occupies a slot, and all per-slot state is
+ * kept as bit vectors over the slots: which slots are occupied, which
+ * hold an instruction that is ready to issue (overall and per op class),
+ * and an age matrix whose row for a slot has a bit set for every slot
+ * holding an older instruction. The oldest ready instruction is the
+ * ready slot whose row has no bit in common with the ready vector, so
+ * picking it and masking out op classes without a free FU only needs
+ * word-wide AND/OR operations over short arrays, which the compiler can
+ * vectorise. Nothing is allocated after construction.
+ *
+ * The matrix only knows about slots; keeping track of which instruction
+ * sits in which slot is up to the IQ.
+ */
+class IssueMatrix
+{
+  public:
+    /** Slot number returned when no slot qualifies. */
+    static const int NoSlot = -1;
+
+    /** @param num_slots Number of IQ entries. */
+    explicit IssueMatrix(unsigned num_slots);
+
+    /** Clears all slots. */
+    void reset();
+
+    /** Returns the number of slots. */
+    unsigned numSlots() const { return slotClass.size(); }
+
+    /**
+     * Occupies a free slot with an instruction younger than all those
+     * currently in the matrix.
+     * @return The slot allocated.
+     */
+    int allocate();
+
+    /** Frees an occupied slot, dropping it from the ready vectors. */
+    void free(int slot);
+
+    /** Marks the instruction in a slot as ready to issue. */
+    void setReady(int slot, OpClass op_class);
+
+    /** Marks the instruction in a slot as no longer ready. */
+    void clearReady(int slot);
+
+    /** Is the instruction in a slot ready to issue? */
+    bool isReady(int slot) const { return testBit(ready, slot); }
+
+    /** Is any instruction ready to issue? */
+    bool anyReady() const;
+
+    /** Returns the number of ready instructions. */
+    unsigned numReady() const;
+
+    /** Op class an instruction was marked ready with. */
+    OpClass opClass(int slot) const { return slotClass[slot]; }
+
+    /**
+     * Starts a select pass: all ready instructions become candidates.
+     */
+    void beginSelect();
+
+    /**
+     * Returns the oldest candidate of the current select pass and removes
+     * it from the candidates, or NoSlot if there are none left.
+     */
+    int selectOldest();
+
+    /**
+     * Removes all instructions of an op class from the candidates of the
+     * current select pass, e.g. because no FU is free for them.
+     */
+    void excludeOpClass(OpClass op_class);
+
+  private:
+    typedef uint64_t Word;
+    static const unsigned WordBits = 64;
+
+    static bool
+    testBit(const std::vector<Word> &vec, int slot)
+    {
+        return vec[slot / WordBits] & (Word(1) << (slot % WordBits));
+    }
+
+    static void
+    setBit(std::vector<Word> &vec, int slot)
+    {
+        vec[slot / WordBits] |= Word(1) << (slot % WordBits);
+    }
+
+    static void
+    clearBit(std::vector<Word> &vec, int slot)
+    {
+        vec[slot / WordBits] &= ~(Word(1) << (slot % WordBits));
+    }
+
+    /** Returns a pointer to the first word of a slot's age row. */
+    Word *olderRow(int slot) { return &older[slot * numWords]; }
+    const Word *
+    olderRow(int slot) const
+    {
+        return &older[slot * numWords];
+    }
+
+    /** Number of words in each bit vector. */
+    const unsigned numWords;
+
+    /** Occupied slots. */
+    std::vector<Word> valid;
+
+    /** Slots holding an instruction that is ready to issue. */
+    std::vector<Word> ready;
+
+    /** Ready slots, per op class. */
+    std::vector<Word> classReady[Num_OpClasses];
+
+    /** Candidates of the current select pass. */
+    std::vector<Word> candidates;
+
+    /**
+     * Age matrix, one row of numWords words per slot. Bit j of the row
+     * for slot i is set if slot j holds an older instruction than slot i.
+     */
+    std::vector<Word> older;
+
+    /** Op class each ready slot was marked ready with. */
+    std::vector<OpClass> slotClass;
+
+    /** Free slots, used as a stack. */
+    std::vector<int> freeSlots;
+};
+
+#endif // __CPU_O3_ISSUE_MATRIX_HH__
@@ -0,0 +1,146 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+
+LSQAddrIndex::LSQAddrIndex(unsigned num_slots)
+    : nodeBlock(num_slots * NodesPerSlot),
+      nodePrev(num_slots * NodesPerSlot, NoNode),
+      nodeNext(num_slots * NodesPerSlot, NoNode),
+      slotNodes(num_slots, 0), slotWide(num_slots, false),
+      buckets(1 << ceilLog2(std::max(num_slots * NodesPerSlot * 2, 1U)),
+              NoNode),
+      bucketMask(buckets.size() - 1)
+{
+    wideSlots.reserve(num_slots);
+}
+
+void
+LSQAddrIndex::clear()
+{
+    std::fill(slotNodes.begin(), slotNodes.end(), 0);
+    std::fill(slotWide.begin(), slotWide.end(), false);
+    std::fill(buckets.begin(), buckets.end(), NoNode);
+    wideSlots.clear();
+}
+
+void
+LSQAddrIndex::link(int node, Addr block)
+{
+    const unsigned b = bucket(block);
+    nodeBlock[node] = block;
+    nodePrev[node] = NoNode;
+    nodeNext[node] = buckets[b];
+    if (buckets[b] != NoNode)
+        nodePrev[buckets[b]] = node;
+    buckets[b] = node;
+}
+
+void
+LSQAddrIndex::unlink(int node)
+{
+    if (nodePrev[node] != NoNode)
+        nodeNext[nodePrev[node]] = nodeNext[node];
+    else
+        buckets[bucket(nodeBlock[node])] = nodeNext[node];
+    if (nodeNext[node] != NoNode)
+        nodePrev[nodeNext[node]] = nodePrev[node];
+}
+
+void
+LSQAddrIndex::insert(unsigned slot, Addr first_block, Addr last_block)
+{
+    assert(first_block <= last_block);
+
+    remove(slot);
+    for (Addr block = first_block; block <= last_block; ++block) {
+        add(slot, block);
+        if (slotWide[slot])
+            break;
+    }
+}
+
+void
+LSQAddrIndex::add(unsigned slot, Addr block)
+{
+    assert(slot < slotNodes.size());
+
+    if (slotWide[slot])
+        return;
+
+    const int first_node = slot * NodesPerSlot;
+    for (int node = first_node; node < first_node + slotNodes[slot]; ++node) {
+        if (nodeBlock[node] == block)
+            return;
+    }
+
+    if (slotNodes[slot] == NodesPerSlot) {
+        // Out of nodes, fall back to checking this slot on every lookup.
+        for (int node = first_node; node < first_node + NodesPerSlot; ++node)
+            unlink(node);
+        slotNodes[slot] = 0;
+        slotWide[slot] = true;
+        wideSlots.push_back(slot);
+        return;
+    }
+
+    link(first_node + slotNodes[slot]++, block);
+}
+
+void
+LSQAddrIndex::remove(unsigned slot)
+{
+    assert(slot < slotNodes.size());
+
+    if (slotWide[slot]) {
+        slotWide[slot] = false;
+        wideSlots.erase(std::find(wideSlots.begin(), wideSlots.end(), slot));
+        return;
+    }
+
+    const int first_node = slot * NodesPerSlot;
+    for (int node = first_node; node < first_node + slotNodes[slot]; ++node)
+        unlink(node);
+    slotNodes[slot] = 0;
+}
+
+void
+LSQAddrIndex::find(Addr first_block, Addr last_block,
+                   std::vector<unsigned> &slots) const
+{
+    for (Addr block = first_block; block <= last_block; ++block) {
+        for (int node = buckets[bucket(block)]; node != NoNode;
+             node = nodeNext[node]) {
+            if (nodeBlock[node] == block)
+                slots.push_back(node / NodesPerSlot);
+        }
+    }
+    slots.insert(slots.end(), wideSlots.begin(), wideSlots.end());
+}
@@ -0,0 +1,114 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * Index of the entries of a load or store queue by the blocks of memory
+ * they access, so that forwarding, ordering violation and snoop checks
+ * only need to look at the entries that may overlap instead of walking
+ * the whole queue.
+ *
+ * Entries are identified by their slot in the queue and blocks by an
+ * address shifted right by the block size; both are chosen by the user.
+ * An entry can be registered under at most two blocks, which covers any
+ * access that does not cross more than one block boundary. Entries that
+ * touch more blocks are kept on a separate list and returned by every
+ * lookup. The index is conservative: lookups may return entries that do
+ * not overlap the access, and callers are expected to apply their exact
+ * checks to the entries returned.
+ *
+ * All storage is allocated up front, a lookup costs one hash bucket walk
+ * per block, and registering or removing an entry is constant time.
+ */
+class LSQAddrIndex
+{
+  public:
+    /** @param num_slots Number of slots in the queue being indexed. */
+    explicit LSQAddrIndex(unsigned num_slots = 0);
+
+    /** Removes all entries. */
+    void clear();
+
+    /**
+     * Registers a slot under the blocks first_block to last_block,
+     * replacing any earlier registration of the same slot.
+     */
+    void insert(unsigned slot, Addr first_block, Addr last_block);
+
+    /** Adds a block to the blocks a slot is registered under. */
+    void add(unsigned slot, Addr block);
+
+    /** Removes a slot from the index. */
+    void remove(unsigned slot);
+
+    /**
+     * Appends the slots that may access any of the blocks first_block to
+     * last_block to a vector. A slot registered under several of those
+     * blocks is appended once for each.
+     */
+    void find(Addr first_block, Addr last_block,
+              std::vector<unsigned> &slots) const;
+
+  private:
+    /** Maximum number of blocks a slot is registered under. */
+    static const int NodesPerSlot = 2;
+
+    static const int NoNode = -1;
+
+    unsigned
+    bucket(Addr block) const
+    {
+        return (block * 0x9e3779b97f4a7c15ULL >> 32) & bucketMask;
+    }
+
+    void link(int node, Addr block);
+    void unlink(int node);
+
+    /** Block, previous and next node of each node in its bucket. Node
+     *  n belongs to slot n / NodesPerSlot.
+     */
+    std::vector<Addr> nodeBlock;
+    std::vector<int> nodePrev;
+    std::vector<int> nodeNext;
+
+    /** Number of nodes in use by each slot. */
+    std::vector<int> slotNodes;
+
+    /** Slots registered under too many blocks to be hashed. */
+    std::vector<bool> slotWide;
+    std::vector<unsigned> wideSlots;
+
+    /** First node of each hash bucket. */
+    std::vector<int> buckets;
+    unsigned bucketMask;
+};
+
+#endif // __CPU_O3_LSQ_ADDR_INDEX_HH__
@@ -47,12 +47,14 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
 #include "arch/locked_mem.hh"
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -498,6 +500,57 @@ class LSQUnit
     LoadQueue loadQueue;
 
   private:
+    /** Loads by the blocks of virtual memory they read, used to find
+     *  memory ordering violations.
+     */
+    LSQAddrIndex loadAddrIndex;
+
+    /** Loads by the physical cache lines they read, used to find the
+     *  loads hit by a snoop.
+     */
+    LSQAddrIndex loadPaddrIndex;
+
+    /** Stores by the blocks of virtual memory they write, used to find
+     *  the stores a load may forward from.
+     */
+    LSQAddrIndex storeAddrIndex;
+
+    /** Shift turning a virtual address into a block number for the
+     *  address indices. Blocks are at least a cache line and at least the
+     *  granularity of the dependence check.
+     */
+    unsigned addrIndexShift;
+
+    /** Scratch list of the queue slots returned by an address index. */
+    std::vector<unsigned> indexHits;
+
+    /** Adds a load that is about to access memory to the indices. */
+    void indexLoad(int load_idx, LSQRequest *req);
+
+    /** Removes a load from the indices. */
+    void unindexLoad(int load_idx);
+
+    /** Last block touched by an access, for the address indices. */
+    Addr
+    lastIndexBlock(Addr addr, unsigned size) const
+    {
+        return (addr + std::max(size, 1U) - 1) >> addrIndexShift;
+    }
+
+    /** Sorts queue slots from oldest to youngest, dropping duplicates. */
+    template <class Queue>
+    static void
+    sortByAge(const Queue &queue, std::vector<unsigned> &slots)
+    {
+        const uint32_t head = queue.head();
+        std::sort(slots.begin(), slots.end(),
+                  [&queue, head](unsigned a, unsigned b) {
+                      return queue.moduloSub(a, head) <
+                          queue.moduloSub(b, head);
+                  });
+        slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    }
+
     /** The number of places to shift addresses in the LSQ before checking
      * for dependency violations
      */
@@ -669,6 +722,10 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
             load_inst->seqNum, load_inst->pcState());
     }
 
+    // From here on the load has a valid address and may be checked for
+    // ordering violations and snoops.
+    indexLoad(load_idx, req);
+
     DPRINTF(LSQUnit, "Read called, load idx: %i, store idx: %i, "
             "storeHead: %i addr: %#x%s\n",
             load_idx - 1, load_inst->sqIt._idx, storeQueue.head() - 1,
@@ -731,13 +788,24 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
         }
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
-    auto store_it = load_inst->sqIt;
-    assert (store_it >= storeWBIt);
-    // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt) {
-        // Move the index to one younger
-        store_it--;
+    // Check the SQ for any previous stores that might lead to forwarding,
+    // youngest first. Only the stores the address index reports as
+    // possibly overlapping the load need to be checked.
+    assert (load_inst->sqIt >= storeWBIt);
+    indexHits.clear();
+    storeAddrIndex.find(
+        req->mainRequest()->getVaddr() >> addrIndexShift,
+        lastIndexBlock(req->mainRequest()->getVaddr(),
+                       req->mainRequest()->getSize()),
+        indexHits);
+    sortByAge(storeQueue, indexHits);
+
+    for (auto hit = indexHits.rbegin(); hit != indexHits.rend(); ++hit) {
+        auto store_it = storeQueue.getIterator(*hit);
+        // Only stores older than the load that have not been sent to
+        // memory yet can forward.
+        if (store_it < storeWBIt || store_it >= load_inst->sqIt)
+            continue;
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -968,6 +1036,13 @@ LSQUnit<Impl>::write(LSQRequest *req, uint8_t *data, int store_idx)
     storeQueue[store_idx].setRequest(req);
     unsigned size = req->_size;
     storeQueue[store_idx].size() = size;
+
+    // Stores without data are never forwarded from.
+    if (size != 0) {
+        const Addr addr = storeQueue[store_idx].instruction()->effAddr;
+        storeAddrIndex.insert(store_idx, addr >> addrIndexShift,
+                              lastIndexBlock(addr, size));
+    }
     bool store_no_data =
         req->mainRequest()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
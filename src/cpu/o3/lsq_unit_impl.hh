@@ -45,6 +45,7 @@
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/locked_mem.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -166,7 +167,8 @@ LSQUnit<Impl>::completeDataAccess(PacketPtr pkt)
         }
     }
 
-    cpu->ppDataAccessComplete->notify(std::make_pair(inst, pkt));
+    cpu->ppDataAccessComplete->notifyWith(
+        [&] { return std::make_pair(inst, pkt); });
 
     /* Notify the sender state that the access is complete (for ownership
      * tracking). */
@@ -203,6 +205,8 @@ LSQUnit<Impl>::completeDataAccess(PacketPtr pkt)
 template <class Impl>
 LSQUnit<Impl>::LSQUnit(uint32_t lqEntries, uint32_t sqEntries)
     : lsqID(-1), storeQueue(sqEntries+1), loadQueue(lqEntries+1),
+      loadAddrIndex(lqEntries+1), loadPaddrIndex(lqEntries+1),
+      storeAddrIndex(sqEntries+1), addrIndexShift(0),
       loads(0), stores(0), storesToWB(0),
       htmStarts(0), htmStops(0),
       lastRetiredHtmUid(0),
@@ -254,6 +258,12 @@ LSQUnit<Impl>::resetState()
     stalled = false;
 
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
+
+    loadAddrIndex.clear();
+    loadPaddrIndex.clear();
+    storeAddrIndex.clear();
+    addrIndexShift = std::max(depCheckShift,
+                              (unsigned)floorLog2(cpu->cacheLineSize()));
 }
 
 template<class Impl>
@@ -419,6 +429,33 @@ LSQUnit<Impl>::getMemDepViolator()
     return temp;
 }
 
+template <class Impl>
+void
+LSQUnit<Impl>::indexLoad(int load_idx, LSQRequest *req)
+{
+    const DynInstPtr &load_inst = loadQueue[load_idx].instruction();
+
+    loadAddrIndex.insert(load_idx, load_inst->effAddr >> addrIndexShift,
+                         lastIndexBlock(load_inst->effAddr,
+                                        load_inst->effSize));
+
+    // Fragments of a split request that faulted have no physical address
+    // and can't be hit by a snoop.
+    loadPaddrIndex.remove(load_idx);
+    for (const auto &r : req->_requests) {
+        if (r->hasPaddr())
+            loadPaddrIndex.add(load_idx, r->getPaddr() & cacheBlockMask);
+    }
+}
+
+template <class Impl>
+void
+LSQUnit<Impl>::unindexLoad(int load_idx)
+{
+    loadAddrIndex.remove(load_idx);
+    loadPaddrIndex.remove(load_idx);
+}
+
 template <class Impl>
 unsigned
 LSQUnit<Impl>::numFreeLoadEntries()
@@ -478,7 +515,28 @@ LSQUnit<Impl>::checkSnoop(PacketPtr pkt)
 
     bool force_squash = false;
 
-    while (++iter != loadQueue.end()) {
+    // Only the loads that read the invalidated block can be hit, but with
+    // TSO every load younger than the first one hit is squashed as well.
+    indexHits.clear();
+    loadPaddrIndex.find(invalidate_addr, invalidate_addr, indexHits);
+    sortByAge(loadQueue, indexHits);
+
+    auto hit = indexHits.begin();
+    while (true) {
+        if (force_squash) {
+            if (++iter == loadQueue.end())
+                break;
+        } else if (hit != indexHits.end()) {
+            // The head load has been dealt with above.
+            if (*hit == loadQueue.head()) {
+                ++hit;
+                continue;
+            }
+            iter = loadQueue.getIterator(*hit++);
+        } else {
+            break;
+        }
+
         ld_inst = iter->instruction();
         assert(ld_inst);
         req = iter->request();
@@ -536,10 +594,21 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
      */
-    while (loadIt != loadQueue.end()) {
-        DynInstPtr ld_inst = loadIt->instruction();
+    // Only the younger loads the address index reports as possibly
+    // overlapping need to be checked, oldest first.
+    indexHits.clear();
+    loadAddrIndex.find(inst->effAddr >> addrIndexShift,
+                       lastIndexBlock(inst->effAddr, inst->effSize),
+                       indexHits);
+    sortByAge(loadQueue, indexHits);
+
+    for (unsigned slot : indexHits) {
+        auto ld_it = loadQueue.getIterator(slot);
+        if (ld_it < loadIt)
+            continue;
+
+        DynInstPtr ld_inst = ld_it->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
             continue;
         }
 
@@ -595,8 +664,6 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
                     inst->seqNum, ld_inst->seqNum, ld_eff_addr1);
             }
         }
-
-        ++loadIt;
     }
     return NoFault;
 }
@@ -734,6 +801,7 @@ LSQUnit<Impl>::commitLoad()
     DPRINTF(LSQUnit, "Committing head load instruction, PC %s\n",
             loadQueue.front().instruction()->pcState());
 
+    unindexLoad(loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 
@@ -973,6 +1041,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        unindexLoad(loadQueue.tail());
         loadQueue.back().clear();
 
         --loads;
@@ -1046,6 +1115,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        storeAddrIndex.remove(storeQueue.tail());
         storeQueue.back().clear();
         --stores;
 
@@ -1166,6 +1236,7 @@ LSQUnit<Impl>::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeAddrIndex.remove(storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
             --stores;
@@ -117,25 +117,25 @@ ElasticTrace::regEtraceListeners()
         " probe listeners", curTick(), cpu->numSimulatedInsts());
     // Create new listeners: provide method to be called upon a notify() for
     // each probe point.
-    listeners.push_back(new ProbeListenerArg<ElasticTrace, RequestPtr>(this,
-                        "FetchRequest", &ElasticTrace::fetchReqTrace));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace,
-            DynInstConstPtr>(this, "Execute",
-                &ElasticTrace::recordExecTick));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace,
-            DynInstConstPtr>(this, "ToCommit",
-                &ElasticTrace::recordToCommTick));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace,
-            DynInstConstPtr>(this, "Rename",
-                &ElasticTrace::updateRegDep));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace, SeqNumRegPair>(this,
-                        "SquashInRename", &ElasticTrace::removeRegDepMapEntry));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace,
-            DynInstConstPtr>(this, "Squash",
-                &ElasticTrace::addSquashedInst));
-    listeners.push_back(new ProbeListenerArg<ElasticTrace,
-            DynInstConstPtr>(this, "Commit",
-                &ElasticTrace::addCommittedInst));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace, RequestPtr,
+            &ElasticTrace::fetchReqTrace>(this, "FetchRequest"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace,
+            DynInstConstPtr, &ElasticTrace::recordExecTick>(this,
+                "Execute"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace,
+            DynInstConstPtr, &ElasticTrace::recordToCommTick>(this,
+                "ToCommit"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace,
+            DynInstConstPtr, &ElasticTrace::updateRegDep>(this,
+                "Rename"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace, SeqNumRegPair,
+            &ElasticTrace::removeRegDepMapEntry>(this, "SquashInRename"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace,
+            DynInstConstPtr, &ElasticTrace::addSquashedInst>(this,
+                "Squash"));
+    listeners.push_back(new ProbeListenerMethod<ElasticTrace,
+            DynInstConstPtr, &ElasticTrace::addCommittedInst>(this,
+                "Commit"));
     allProbesReg = true;
 }
 
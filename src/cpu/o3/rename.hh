@@ -44,7 +44,9 @@
 
 #include <list>
 #include <utility>
+#include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/timebuf.hh"
@@ -296,6 +298,11 @@ class DefaultRename
      * register for that arch. register, and the new physical register.
      */
     struct RenameHistory {
+        RenameHistory()
+            : instSeqNum(0), newPhysReg(nullptr), prevPhysReg(nullptr)
+        {
+        }
+
         RenameHistory(InstSeqNum _instSeqNum, const RegId& _archReg,
                       PhysRegIdPtr _newPhysReg,
                       PhysRegIdPtr _prevPhysReg)
@@ -315,10 +322,18 @@ class DefaultRename
         PhysRegIdPtr prevPhysReg;
     };
 
+    typedef CircularQueue<RenameHistory> HistoryBuffer;
+
     /** A per-thread list of all destination register renames, used to either
-     * undo rename mappings or free old physical registers.
+     * undo rename mappings or free old physical registers. Entries are in
+     * program order: new renames are appended at the back, squashes undo
+     * them from the back, and commits free them from the front. Renames
+     * live until rename learns that their instruction committed, so there
+     * is room for a ROB's worth of instructions plus those committed during
+     * the commit to rename delay, each writing the maximum number of
+     * registers.
      */
-    std::list<RenameHistory> historyBuffer[Impl::MaxThreads];
+    std::vector<HistoryBuffer> historyBuffer;
 
     /** Pointer to CPU. */
     O3CPU *cpu;
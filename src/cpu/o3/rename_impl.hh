@@ -57,7 +57,11 @@ using namespace std;
 
 template <class Impl>
 DefaultRename<Impl>::DefaultRename(O3CPU *_cpu, DerivO3CPUParams *params)
-    : cpu(_cpu),
+    : historyBuffer(Impl::MaxThreads, HistoryBuffer(
+          (params->numROBEntries +
+           params->commitToRenameDelay * params->commitWidth) *
+          TheISA::MaxInstDestRegs)),
+      cpu(_cpu),
       iewToRenameDelay(params->iewToRenameDelay),
       decodeToRenameDelay(params->decodeToRenameDelay),
       commitToRenameDelay(params->commitToRenameDelay),
@@ -927,16 +931,13 @@ template <class Impl>
 void
 DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].begin();
-
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     // Go through the most recent instructions, undoing the mappings
     // they did and freeing up the registers.
     while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+           historyBuffer[tid].back().instSeqNum > squashed_seq_num) {
+        const RenameHistory *hb_it = &historyBuffer[tid].back();
 
         DPRINTF(Rename, "[tid:%i] Removing history entry with sequence "
                 "number %i (archReg: %d, newPhysReg: %d, prevPhysReg: %d).\n",
@@ -960,11 +961,11 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
-        // that this is done before hb_it is incremented.
+        // that this is done before the entry is removed.
         ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
                                                 hb_it->newPhysReg));
 
-        historyBuffer[tid].erase(hb_it++);
+        historyBuffer[tid].pop_back();
 
         ++stats.undoneMaps;
     }
@@ -981,15 +982,10 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].end();
-
-    --hb_it;
-
     if (historyBuffer[tid].empty()) {
         DPRINTF(Rename, "[tid:%i] History buffer is empty.\n", tid);
         return;
-    } else if (hb_it->instSeqNum > inst_seq_num) {
+    } else if (historyBuffer[tid].front().instSeqNum > inst_seq_num) {
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Old sequence number encountered. "
                 "Ensure that a syscall happened recently.\n",
@@ -1002,8 +998,8 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     // rename histories if they did not have destination registers that were
     // renamed.
     while (!historyBuffer[tid].empty() &&
-           hb_it != historyBuffer[tid].end() &&
-           hb_it->instSeqNum <= inst_seq_num) {
+           historyBuffer[tid].front().instSeqNum <= inst_seq_num) {
+        const RenameHistory *hb_it = &historyBuffer[tid].front();
 
         DPRINTF(Rename, "[tid:%i] Freeing up older rename of reg %i (%s), "
                 "[sn:%llu].\n",
@@ -1020,7 +1016,7 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
 
         ++stats.committedMaps;
 
-        historyBuffer[tid].erase(hb_it--);
+        historyBuffer[tid].pop_front();
     }
 }
 
@@ -1125,11 +1121,13 @@ DefaultRename<Impl>::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
                                rename_result.first,
                                rename_result.second);
 
-        historyBuffer[tid].push_front(hb_entry);
+        panic_if(historyBuffer[tid].full(),
+                 "Rename history buffer of thread %i is full.", tid);
+        historyBuffer[tid].push_back(hb_entry);
 
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Adding instruction to history buffer (size=%i).\n",
-                tid,(*historyBuffer[tid].begin()).instSeqNum,
+                tid, historyBuffer[tid].back().instSeqNum,
                 historyBuffer[tid].size());
 
         // Tell the instruction to rename the appropriate destination
@@ -1432,13 +1430,13 @@ template <class Impl>
 void
 DefaultRename<Impl>::dumpHistory()
 {
-    typename std::list<RenameHistory>::iterator buf_it;
-
     for (ThreadID tid = 0; tid < numThreads; tid++) {
 
-        buf_it = historyBuffer[tid].begin();
+        // Dump the most recent renames first.
+        auto buf_it = historyBuffer[tid].end();
 
-        while (buf_it != historyBuffer[tid].end()) {
+        while (buf_it != historyBuffer[tid].begin()) {
+            --buf_it;
             cprintf("Seq num: %i\nArch reg[%s]: %i New phys reg:"
                     " %i[%s] Old phys reg: %i[%s]\n",
                     (*buf_it).instSeqNum,
@@ -1448,8 +1446,6 @@ DefaultRename<Impl>::dumpHistory()
                     (*buf_it).newPhysReg->className(),
                     (*buf_it).prevPhysReg->index(),
                     (*buf_it).prevPhysReg->className());
-
-            buf_it++;
         }
     }
 }
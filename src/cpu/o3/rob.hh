@@ -46,6 +46,7 @@
 #include <vector>
 
 #include "arch/registers.hh"
+#include "base/circular_queue.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -64,7 +65,8 @@ class ROB
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef CircularQueue<DynInstPtr> InstList;
+    typedef typename InstList::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -276,8 +278,10 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[Impl::MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** ROB List of Instructions, oldest first. Each thread can hold up to
+     *  numEntries instructions, so the lists never need to grow.
+     */
+    std::vector<InstList> instList;
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -56,6 +56,7 @@ ROB<Impl>::ROB(O3CPU *_cpu, DerivO3CPUParams *params)
     : robPolicy(params->smtROBPolicy),
       cpu(_cpu),
       numEntries(params->numROBEntries),
+      instList(Impl::MaxThreads, InstList(numEntries)),
       squashWidth(params->squashWidth),
       numInstsInROB(0),
       numThreads(params->numThreads),
@@ -244,11 +245,10 @@ ROB<Impl>::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction by moving it out of the list, which
+    // leaves the now unused entry empty, and remove it from the list
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
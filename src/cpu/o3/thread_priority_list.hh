@@ -0,0 +1,111 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_THREAD_PRIORITY_LIST_HH__
+#define __CPU_O3_THREAD_PRIORITY_LIST_HH__
+
+#include <cassert>
+#include <cstdint>
+
+#include "base/types.hh"
+
+/**
+ * Priority order of the threads of an SMT stage, highest priority first,
+ * used by the round robin fetch and commit policies. Threads are kept in
+ * a fixed-size array together with a bitmask of the threads present, so
+ * that selecting a thread and moving it to the back never allocates.
+ */
+template <int MaxThreads>
+class ThreadPriorityList
+{
+    static_assert(MaxThreads <= 32, "Thread mask too small");
+
+  public:
+    ThreadPriorityList() : size(0), mask(0) {}
+
+    bool empty() const { return size == 0; }
+
+    void
+    clear()
+    {
+        size = 0;
+        mask = 0;
+    }
+
+    bool contains(ThreadID tid) const { return mask & (1U << tid); }
+
+    /** Adds a thread with the lowest priority. */
+    void
+    push_back(ThreadID tid)
+    {
+        assert(tid >= 0 && tid < MaxThreads && !contains(tid));
+        order[size++] = tid;
+        mask |= 1U << tid;
+    }
+
+    /** Removes a thread if present. */
+    void
+    remove(ThreadID tid)
+    {
+        if (!contains(tid))
+            return;
+
+        int pos = 0;
+        while (order[pos] != tid)
+            ++pos;
+        for (; pos < size - 1; ++pos)
+            order[pos] = order[pos + 1];
+        --size;
+        mask &= ~(1U << tid);
+    }
+
+    /**
+     * Selects the highest priority thread that passes a check and gives
+     * it the lowest priority.
+     * @return The thread selected, or InvalidThreadID if none qualifies.
+     */
+    template <class Check>
+    ThreadID
+    select(Check check)
+    {
+        for (int pos = 0; pos < size; ++pos) {
+            const ThreadID tid = order[pos];
+            if (check(tid)) {
+                for (; pos < size - 1; ++pos)
+                    order[pos] = order[pos + 1];
+                order[size - 1] = tid;
+                return tid;
+            }
+        }
+        return InvalidThreadID;
+    }
+
+  private:
+    ThreadID order[MaxThreads];
+    int size;
+    uint32_t mask;
+};
+
+#endif // __CPU_O3_THREAD_PRIORITY_LIST_HH__
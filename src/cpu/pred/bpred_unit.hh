@@ -42,7 +42,8 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
-#include <deque>
+#include <cassert>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "base/types.hh"
@@ -201,6 +202,10 @@ class BPredUnit : public SimObject
               inst(inst)
         {}
 
+        PredictorHistory()
+            : PredictorHistory(0, 0, false, NULL, NULL, 0, NULL)
+        {}
+
         bool operator==(const PredictorHistory &entry) const {
             return this->seqNum == entry.seqNum;
         }
@@ -252,10 +257,84 @@ class BPredUnit : public SimObject
         Addr target;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
     };
 
-    typedef std::deque<PredictorHistory> History;
+    /**
+     * The in-flight predictions of one thread, newest at the front.
+     * Entries are added at the front when a branch is predicted and
+     * leave from the back when it commits or from the front when it is
+     * squashed, so they are kept in a ring which only allocates when it
+     * has to grow rather than in a deque which allocates and frees blocks
+     * as the window of in-flight branches slides along.
+     */
+    class History
+    {
+      private:
+        std::vector<PredictorHistory> entries;
+
+        /** Index of the front (newest) entry */
+        size_t head;
+
+        size_t count;
+
+        size_t wrap(size_t idx) const { return idx & (entries.size() - 1); }
+
+        /** Double the capacity of the ring, keeping the entries in order */
+        void
+        grow()
+        {
+            std::vector<PredictorHistory> grown(entries.size() * 2);
+            for (size_t i = 0; i < count; ++i)
+                grown[i] = entries[wrap(head + i)];
+            entries.swap(grown);
+            head = 0;
+        }
+
+      public:
+        History() : entries(16), head(0), count(0) {}
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+
+        /** Entry idx places from the front */
+        PredictorHistory &operator[](size_t idx)
+        { return entries[wrap(head + idx)]; }
+        const PredictorHistory &operator[](size_t idx) const
+        { return entries[wrap(head + idx)]; }
+
+        PredictorHistory &front() { return (*this)[0]; }
+        PredictorHistory &back() { return (*this)[count - 1]; }
+
+        void
+        push_front(const PredictorHistory &entry)
+        {
+            if (count == entries.size())
+                grow();
+            head = wrap(head - 1);
+            entries[head] = entry;
+            ++count;
+        }
+
+        /** Popped entries drop their instruction so that it is released
+         *  as it would be if the entry were destroyed */
+        void
+        pop_front()
+        {
+            assert(count);
+            front().inst = NULL;
+            head = wrap(head + 1);
+            --count;
+        }
+
+        void
+        pop_back()
+        {
+            assert(count);
+            back().inst = NULL;
+            --count;
+        }
+    };
 
     /** Number of the threads for which the branch history is maintained. */
     const unsigned numThreads;
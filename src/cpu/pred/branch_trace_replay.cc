@@ -0,0 +1,182 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replay.hh"
+
+#include "arch/types.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "config/the_isa.hh"
+#include "debug/Branch.hh"
+#include "proto/branch.pb.h"
+#include "proto/protoio.hh"
+#include "sim/sim_exit.hh"
+
+namespace {
+
+static TheISA::ExtMachInst replayMachInst;
+
+/**
+ * A control instruction which exists only to carry the flags of a traced
+ * branch into a predictor.
+ */
+class ReplayBranchInst : public StaticInst
+{
+  public:
+    ReplayBranchInst(uint32_t branch_flags)
+        : StaticInst("replay branch", replayMachInst, No_OpClass)
+    {
+        flags[IsControl] = true;
+        if (branch_flags & ProtoMessage::Branch::Uncond)
+            flags[IsUncondControl] = true;
+        else
+            flags[IsCondControl] = true;
+        if (branch_flags & ProtoMessage::Branch::Direct)
+            flags[IsDirectControl] = true;
+        else
+            flags[IsIndirectControl] = true;
+        flags[IsCall] = branch_flags & ProtoMessage::Branch::Call;
+        flags[IsReturn] = branch_flags & ProtoMessage::Branch::Return;
+    }
+
+    Fault
+    execute(ExecContext *xc, Trace::InstRecord *traceData) const override
+    {
+        panic("Replayed branches can't be executed\n");
+    }
+
+    void
+    advancePC(TheISA::PCState &pcState) const override
+    {
+        pcState.advance();
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const Loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+}
+
+BranchTraceReplay::BranchTraceReplay(const BranchTraceReplayParams *p)
+    : SimObject(p),
+      traceFile(p->trace_file),
+      predictors(p->predictors),
+      maxBranches(p->max_branches),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(predictors.empty(), "%s: No predictors to replay the trace "
+             "through\n", name());
+
+    for (uint32_t i = 0; i < branchInsts.size(); i++)
+        branchInsts[i] = new ReplayBranchInst(i);
+}
+
+const StaticInstPtr &
+BranchTraceReplay::branchInst(uint32_t flags) const
+{
+    return branchInsts[flags & (branchInsts.size() - 1)];
+}
+
+void
+BranchTraceReplay::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplay::replay()
+{
+    ProtoInputStream trace(traceFile);
+
+    ProtoMessage::BranchHeader header_msg;
+    if (!trace.read(header_msg))
+        fatal("%s: Failed to read header from %s\n", name(), traceFile);
+
+    ProtoMessage::Branch branch_msg;
+    InstSeqNum seq_num = 0;
+
+    while ((!maxBranches || seq_num < maxBranches) &&
+           trace.read(branch_msg)) {
+        ++seq_num;
+        stats.insts += branch_msg.insts();
+        ++stats.branches;
+
+        const StaticInstPtr &inst = branchInst(branch_msg.flags());
+        const bool taken = branch_msg.taken();
+
+        TheISA::PCState target(branch_msg.target());
+
+        for (size_t i = 0; i < predictors.size(); i++) {
+            BPredUnit *bp = predictors[i];
+
+            // Give the PC state the fall through address the decoder
+            // would have, which is what the RAS pushes for calls
+            TheISA::PCState pc(branch_msg.pc());
+            pc.npc(branch_msg.pc() + branch_msg.size());
+
+            const bool pred_taken = bp->predict(inst, seq_num, pc, 0);
+
+            if (pred_taken != taken ||
+                (taken && pc.instAddr() != target.instAddr())) {
+                DPRINTF(Branch, "%s: [sn:%llu] PC %#x mispredicted\n",
+                        bp->name(), seq_num, branch_msg.pc());
+                ++stats.mispredicted[i];
+                bp->squash(seq_num, target, taken, 0);
+            }
+
+            bp->update(seq_num, 0);
+        }
+    }
+
+    exitSimLoop("branch trace replay complete");
+}
+
+BranchTraceReplay::BranchTraceReplayStats::BranchTraceReplayStats(
+    BranchTraceReplay *parent)
+    : Stats::Group(parent),
+      ADD_STAT(insts, "Number of instructions covered by the trace"),
+      ADD_STAT(branches, "Number of branches replayed"),
+      ADD_STAT(mispredicted, "Number of mispredicted branches"),
+      ADD_STAT(mpki, "Mispredictions per thousand instructions",
+               mispredicted * 1000 / insts)
+{
+    const std::vector<BPredUnit *> &predictors = parent->predictors;
+
+    mispredicted.init(predictors.size());
+    for (size_t i = 0; i < predictors.size(); i++)
+        mispredicted.subname(i, predictors[i]->name());
+    mpki.precision(4);
+}
+
+BranchTraceReplay *
+BranchTraceReplayParams::create()
+{
+    return new BranchTraceReplay(this);
+}
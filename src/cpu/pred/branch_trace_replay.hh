@@ -0,0 +1,96 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/static_inst.hh"
+#include "params/BranchTraceReplay.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * Plays a branch trace recorded by BranchTraceProbe through a set of
+ * branch predictors, without simulating a CPU, and then ends the
+ * simulation. All of the predictors are fed from a single pass over the
+ * trace.
+ *
+ * Each branch is predicted, corrected if mispredicted and committed
+ * before the next one is looked at, as for a CPU that never has more
+ * than one branch in flight. The predictors' own statistics, and the
+ * misprediction counts and MPKI kept here, describe the run.
+ */
+class BranchTraceReplay : public SimObject
+{
+  public:
+    BranchTraceReplay(const BranchTraceReplayParams *params);
+
+    void startup() override;
+
+  private:
+    /** Play the whole trace, then exit the simulation loop */
+    void replay();
+
+    /**
+     * Static instruction standing in for traced branches with the given
+     * ProtoMessage::Branch flags. Predictors only look at an
+     * instruction's control flags, and at how it advances the PC.
+     */
+    const StaticInstPtr &branchInst(uint32_t flags) const;
+
+    const std::string traceFile;
+
+    const std::vector<BPredUnit *> predictors;
+
+    /** Stop after this many branches, 0 for the whole trace */
+    const uint64_t maxBranches;
+
+    EventFunctionWrapper replayEvent;
+
+    /** One stand-in instruction for each combination of flags */
+    std::array<StaticInstPtr, 16> branchInsts;
+
+    struct BranchTraceReplayStats : public Stats::Group
+    {
+        BranchTraceReplayStats(BranchTraceReplay *parent);
+
+        /** Instructions covered by the replayed trace */
+        Stats::Scalar insts;
+        /** Branches replayed */
+        Stats::Scalar branches;
+        /** Mispredicted branches, per predictor */
+        Stats::Vector mispredicted;
+        /** Mispredictions per thousand instructions, per predictor */
+        Stats::Formula mpki;
+    } stats;
+};
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
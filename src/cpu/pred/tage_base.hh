@@ -65,12 +65,14 @@ class TAGEBase : public SimObject
     // Prediction Structures
 
     // Tage Entry
+    // The tag is placed first so that the entry packs into 4 bytes
+    // rather than 6, fitting more entries in each host cache line
     struct TageEntry
     {
-        int8_t ctr;
         uint16_t tag;
+        int8_t ctr;
         uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        TageEntry() : tag(0), ctr(0), u(0) { }
     };
 
     // Folded History Table - compressed history
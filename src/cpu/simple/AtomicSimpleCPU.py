@@ -59,6 +59,10 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    block_cache = Param.Bool(False, "Serve instruction fetches from a "
+        "cache of fetched blocks, bypassing the ITB and the instruction "
+        "side of the memory system (for fast-forwarding, does not warm "
+        "the instruction caches)")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -80,16 +80,22 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       width(p->width), locked(false),
       simulate_data_stalls(p->simulate_data_stalls),
       simulate_inst_stalls(p->simulate_inst_stalls),
+      blockCache(p->block_cache ? new InstBlockCache : nullptr),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
-      ppCommit(nullptr)
+      ppCommit(nullptr), ppBranch(nullptr)
 {
     _status = Idle;
     ifetch_req = std::make_shared<Request>();
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
     data_amo_req = std::make_shared<Request>();
+
+    fatal_if(blockCache && simulate_inst_stalls,
+             "%s: The block cache does not model instruction fetch "
+             "latencies, it cannot be used with simulate_inst_stalls.\n",
+             name());
 }
 
 
@@ -150,6 +156,11 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been written by other means while we were
+    // drained, e.g. when restoring a checkpoint.
+    if (blockCache)
+        blockCache->flush();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -198,6 +209,9 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
+
+    if (blockCache)
+        blockCache->flush();
 }
 
 
@@ -302,6 +316,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         for (auto &t_info : cpu->threadInfo) {
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
+
+        if (cpu->blockCache)
+            cpu->blockCache->invalidate(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -329,6 +346,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
     }
+
+    if (cpu->blockCache && (pkt->isInvalidate() || pkt->isWrite()))
+        cpu->blockCache->invalidate(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -518,6 +538,9 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+
+                    if (blockCache)
+                        blockCache->invalidate(req->getPaddr(), frag_size);
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -610,6 +633,9 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+
+            if (blockCache)
+                blockCache->invalidate(req->getPaddr(), size);
         }
 
         dcache_access = true;
@@ -654,6 +680,8 @@ AtomicSimpleCPU::tick()
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
+            if (blockCache && checkInterrupts(curThread))
+                blockCache->endBlock();
             checkForInterrupts();
             checkPcEventQueue();
         }
@@ -670,11 +698,17 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
+        bool cachedFetch = false;
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
-            fault = thread->itb->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseTLB::Execute);
+            cachedFetch = blockCache && blockCache->fetch(
+                    curThread, ifetch_req->getVaddr(),
+                    thread->itb->flushCount(), inst);
+            if (!cachedFetch) {
+                fault = thread->itb->translateAtomic(ifetch_req,
+                        thread->getTC(), BaseTLB::Execute);
+            }
         }
 
         if (fault == NoFault) {
@@ -682,7 +716,7 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !cachedFetch) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -701,18 +735,40 @@ AtomicSimpleCPU::tick()
                     // ifetch_req is initialized to read the instruction directly
                     // into the CPU object's inst field.
                 //}
+
+                if (blockCache && !ifetch_req->isUncacheable()) {
+                    blockCache->fill(curThread, ifetch_req->getVaddr(),
+                                     ifetch_req->getPaddr(),
+                                     thread->itb->flushCount(), inst);
+                }
             }
 
             preExecute();
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
-                fault = curStaticInst->execute(&t_info, traceData);
+                // A taken branch overwrites the decoded next PC, so keep
+                // the fall through address for the Branch probe point
+                const bool trace_branch = curStaticInst->isControl() &&
+                    ppBranch->hasListeners();
+                const Addr fall_through =
+                    trace_branch ? thread->pcState().npc() : 0;
+
+                fault = curStaticInst->executeSimple(&t_info, traceData);
 
                 // keep an instruction count
                 if (fault == NoFault) {
                     countInst();
-                    ppCommit->notify(std::make_pair(thread, curStaticInst));
+                    ppCommit->notifyWith([&] {
+                        return std::make_pair(thread, curStaticInst);
+                    });
+
+                    if (trace_branch) {
+                        const TheISA::PCState pc = thread->pcState();
+                        ppBranch->notify(ProbePoints::BranchInfo{
+                            curStaticInst, pc.instAddr(), fall_through,
+                            pc.npc(), pc.npc() != fall_through});
+                    }
                 } else if (traceData) {
                     traceFault();
                 }
@@ -726,6 +782,16 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                if (blockCache && fault == NoFault &&
+                        InstBlockCache::endsBlock(*curStaticInst)) {
+                    blockCache->endBlock();
+
+                    // System call emulation may write memory without
+                    // going through the CPU ports.
+                    if (!FullSystem && curStaticInst->isSyscall())
+                        blockCache->flush();
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -748,6 +814,10 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        // Faults change the translation regime of the thread.
+        if (blockCache && fault != NoFault)
+            blockCache->endBlock();
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -770,6 +840,7 @@ AtomicSimpleCPU::regProbePoints()
 
     ppCommit = new ProbePointArg<pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
+    ppBranch = new ProbePoints::Branch(getProbeManager(), "Branch");
 }
 
 void
@@ -41,10 +41,14 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
+#include "cpu/simple/inst_block_cache.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
+#include "sim/probe/branch.hh"
 #include "sim/probe/probe.hh"
 
 class AtomicSimpleCPU : public BaseSimpleCPU
@@ -65,6 +69,9 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /** Cache of fetched blocks, only present if enabled. */
+    std::unique_ptr<InstBlockCache> blockCache;
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -168,6 +175,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
+    ProbePoints::Branch *ppBranch;
 
   protected:
 
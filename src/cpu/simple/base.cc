@@ -694,3 +694,10 @@ BaseSimpleCPU::advancePC(const Fault &fault)
         }
     }
 }
+
+Fault
+StaticInst::executeSimple(SimpleExecContext *xc,
+                          Trace::InstRecord *traceData) const
+{
+    return execute(xc, traceData);
+}
@@ -54,7 +54,7 @@
 
 class BaseSimpleCPU;
 
-class SimpleExecContext : public ExecContext {
+class SimpleExecContext final : public ExecContext {
   protected:
     using VecRegContainer = TheISA::VecRegContainer;
     using VecElem = TheISA::VecElem;
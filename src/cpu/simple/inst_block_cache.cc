@@ -0,0 +1,90 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/inst_block_cache.hh"
+
+#include <algorithm>
+
+InstBlockCache::InstBlockCache()
+    : block{nullptr, InvalidThreadID, 0, 0, 0}
+{
+}
+
+void
+InstBlockCache::fill(ThreadID tid, Addr vaddr, Addr paddr,
+                     uint64_t tlb_flushes, MachInst inst)
+{
+    const Addr vpage = vaddr & ~PageMask;
+    const Addr ppage = paddr & ~PageMask;
+
+    if (!block.page || block.tid != tid || block.tlbFlushes != tlb_flushes ||
+            block.vpage != vpage || block.ppage != ppage) {
+        block.page = &pages[ppage];
+        block.tid = tid;
+        block.vpage = vpage;
+        block.ppage = ppage;
+        block.tlbFlushes = tlb_flushes;
+    }
+
+    const unsigned idx = wordIndex(paddr);
+    CodePage &page = *block.page;
+    if (!page.valid[idx]) {
+        page.valid[idx] = true;
+        ++page.numValid;
+    }
+    page.words[idx] = inst;
+}
+
+void
+InstBlockCache::invalidateRange(Addr paddr, Addr size)
+{
+    const Addr end = paddr + size;
+    Addr addr = paddr;
+    while (addr < end) {
+        const Addr ppage = addr & ~PageMask;
+        const Addr page_end = std::min(end, ppage + TheISA::PageBytes);
+
+        auto it = pages.find(ppage);
+        if (it != pages.end() && it->second.numValid) {
+            CodePage &page = it->second;
+            const unsigned last = wordIndex(page_end - 1);
+            for (unsigned idx = wordIndex(addr); idx <= last; ++idx) {
+                if (page.valid[idx]) {
+                    page.valid[idx] = false;
+                    --page.numValid;
+                }
+            }
+        }
+
+        addr = page_end;
+    }
+}
+
+void
+InstBlockCache::flush()
+{
+    endBlock();
+    pages.clear();
+}
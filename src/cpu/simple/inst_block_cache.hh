@@ -0,0 +1,172 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/isa_traits.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+/**
+ * A cache of instruction fetches used by the atomic CPU when fast
+ * forwarding. Fetched words are kept per physical page, and the
+ * translation of the page currently being executed is remembered for
+ * the rest of the block, so that once a block has been fetched through
+ * the TLB and the memory system its later fetches are served without
+ * touching either.
+ *
+ * A block ends at any instruction of the owning CPU that may change the
+ * translation regime (serializing, non-speculative and squash-after
+ * instructions, system calls and indirect control transfers), on its
+ * faults and interrupts, and when the ITB of the fetching thread has
+ * been flushed or demapped since the block started, which other CPUs may
+ * do through broadcast TLB maintenance. All the state of a cache belongs
+ * to its CPU, so caches of different CPUs neither disturb each other nor
+ * race when CPUs run in different simulation threads. The cached words
+ * are invalidated by the writes of the owning CPU and by the writes and
+ * invalidations it snoops.
+ */
+class InstBlockCache
+{
+  public:
+    typedef TheISA::MachInst MachInst;
+
+    InstBlockCache();
+
+    /**
+     * Try to fetch an instruction word of the current block.
+     *
+     * @param tid Thread fetching.
+     * @param vaddr Virtual address of the fetch.
+     * @param tlb_flushes Flush count of the thread's ITB.
+     * @param inst Set to the cached instruction word on a hit.
+     * @return true if the fetch was served from the cache.
+     */
+    bool
+    fetch(ThreadID tid, Addr vaddr, uint64_t tlb_flushes,
+          MachInst &inst) const
+    {
+        if (!block.page || block.tid != tid ||
+                block.tlbFlushes != tlb_flushes ||
+                (vaddr & ~PageMask) != block.vpage) {
+            return false;
+        }
+
+        const unsigned idx = wordIndex(vaddr);
+        if (!block.page->valid[idx])
+            return false;
+
+        inst = block.page->words[idx];
+        return true;
+    }
+
+    /**
+     * Record an instruction word fetched through the TLB and the memory
+     * system, continuing the current block or starting a new one.
+     */
+    void fill(ThreadID tid, Addr vaddr, Addr paddr, uint64_t tlb_flushes,
+              MachInst inst);
+
+    /**
+     * Check if an instruction ends the current block.
+     */
+    static bool
+    endsBlock(const StaticInst &si)
+    {
+        return si.isSerializing() || si.isNonSpeculative() ||
+            si.isSquashAfter() || si.isSyscall() || si.isQuiesce() ||
+            si.isHtmCmd() || (si.isControl() && !si.isDirectCtrl());
+    }
+
+    /**
+     * End the current block, after an instruction for which endsBlock()
+     * is true, a fault or an interrupt.
+     */
+    void endBlock() { block.page = nullptr; }
+
+    /**
+     * Drop the cached words overlapping a physical address range.
+     */
+    void
+    invalidate(Addr paddr, Addr size)
+    {
+        if (!pages.empty())
+            invalidateRange(paddr, size);
+    }
+
+    /** Drop all cached words, e.g. when memory may have been changed
+     * behind the back of the CPU. */
+    void flush();
+
+  protected:
+    static constexpr Addr PageMask = TheISA::PageBytes - 1;
+    static constexpr unsigned WordsPerPage =
+        TheISA::PageBytes / sizeof(MachInst);
+
+    static unsigned
+    wordIndex(Addr addr)
+    {
+        return (addr & PageMask) / sizeof(MachInst);
+    }
+
+    void invalidateRange(Addr paddr, Addr size);
+
+    /** The cached instruction words of a physical page. */
+    struct CodePage
+    {
+        std::vector<MachInst> words;
+        std::vector<bool> valid;
+        /** Number of valid words, to skip clearing empty pages. */
+        unsigned numValid;
+
+        CodePage() : words(WordsPerPage), valid(WordsPerPage, false),
+                     numValid(0)
+        {}
+    };
+
+    /** Cached pages by physical page address. */
+    std::unordered_map<Addr, CodePage> pages;
+
+    /** The block being executed. */
+    struct Block
+    {
+        /** Page of the block, nullptr if there is no current block. */
+        CodePage *page;
+        ThreadID tid;
+        Addr vpage;
+        Addr ppage;
+        /** Flush count of the ITB when the block started. */
+        uint64_t tlbFlushes;
+    };
+    Block block;
+};
+
+#endif // __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
@@ -44,3 +44,28 @@ class SimPoint(ProbeListenerObject):
 
     interval = Param.UInt64(100000000, "Interval Size (insts)")
     profile_file = Param.String("simpoint.bb.gz", "BBV (output) file")
+
+    # Built-in simulation point selection, following the SimPoint tool:
+    # the BBVs are randomly projected down to a few dimensions and
+    # clustered with k-means for every k up to max_k, and the clustering
+    # is chosen using the Bayesian Information Criterion. The output files
+    # can be passed to --take-simpoint-checkpoints.
+    max_k = Param.Unsigned(0, "Maximum number of clusters, 0 to only "
+                           "write the BBV file")
+    projection_dims = Param.Unsigned(15, "Number of dimensions to project "
+                                     "the BBVs down to")
+    projection_seed = Param.UInt64(2042712918, "Seed of the projection")
+    kmeans_inits = Param.Unsigned(5, "Number of random initialisations of "
+                                  "k-means for each k")
+    kmeans_iters = Param.Unsigned(100, "Maximum number of k-means "
+                                  "iterations")
+    kmeans_seed = Param.UInt64(493575226, "Seed of the k-means "
+                               "initialisation")
+    bic_threshold = Param.Float(0.9, "Fraction of the BIC score range a "
+                                "clustering must reach")
+    simpoint_file = Param.String("simpoint.simpts", "Simulation points "
+                                 "(output) file")
+    weight_file = Param.String("simpoint.weights", "Simulation point "
+                               "weights (output) file")
+    tick_file = Param.String("simpoint.ticks", "Start tick, interval and "
+                             "weight of each simulation point (output) file")
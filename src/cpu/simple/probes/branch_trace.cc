@@ -0,0 +1,116 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/branch_trace.hh"
+
+#include "base/output.hh"
+#include "proto/branch.pb.h"
+#include "sim/core.hh"
+
+BranchTraceProbe::BranchTraceProbe(const BranchTraceProbeParams *p)
+    : ProbeListenerObject(p),
+      traceStream(nullptr),
+      instsSinceBranch(0)
+{
+    traceStream = new ProtoOutputStream(simout.resolve(p->trace_file));
+
+    // The destructor isn't called on exit, so make sure the stream is
+    // flushed and closed
+    registerExitCallback([this]() { closeStreams(); });
+}
+
+void
+BranchTraceProbe::regProbeListeners()
+{
+    typedef ProbeListenerMethod<BranchTraceProbe,
+                                std::pair<SimpleThread*, const StaticInstPtr>,
+                                &BranchTraceProbe::countInst>
+        CommitListener;
+    typedef ProbeListenerMethod<BranchTraceProbe, ProbePoints::BranchInfo,
+                                &BranchTraceProbe::recordBranch>
+        BranchListener;
+
+    listeners.push_back(new CommitListener(this, "Commit"));
+    listeners.push_back(new BranchListener(this, "Branch"));
+}
+
+void
+BranchTraceProbe::startup()
+{
+    ProtoMessage::BranchHeader header_msg;
+    header_msg.set_obj_id(name());
+    traceStream->write(header_msg);
+}
+
+void
+BranchTraceProbe::closeStreams()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+void
+BranchTraceProbe::countInst(
+    const std::pair<SimpleThread*, const StaticInstPtr> &p)
+{
+    const StaticInstPtr &inst = p.second;
+
+    if (!inst->isMicroop() || inst->isLastMicroop())
+        ++instsSinceBranch;
+}
+
+void
+BranchTraceProbe::recordBranch(const ProbePoints::BranchInfo &branch)
+{
+    const StaticInstPtr &inst = branch.inst;
+
+    uint32_t flags = 0;
+    if (inst->isUncondCtrl())
+        flags |= ProtoMessage::Branch::Uncond;
+    if (inst->isDirectCtrl())
+        flags |= ProtoMessage::Branch::Direct;
+    if (inst->isCall())
+        flags |= ProtoMessage::Branch::Call;
+    if (inst->isReturn())
+        flags |= ProtoMessage::Branch::Return;
+
+    ProtoMessage::Branch branch_msg;
+    branch_msg.set_insts(instsSinceBranch);
+    branch_msg.set_pc(branch.pc);
+    branch_msg.set_size(branch.fallThrough - branch.pc);
+    branch_msg.set_target(branch.target);
+    branch_msg.set_taken(branch.taken);
+    branch_msg.set_flags(flags);
+
+    traceStream->write(branch_msg);
+
+    instsSinceBranch = 0;
+}
+
+BranchTraceProbe *
+BranchTraceProbeParams::create()
+{
+    return new BranchTraceProbe(this);
+}
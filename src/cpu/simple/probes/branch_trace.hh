@@ -0,0 +1,67 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
+#define __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
+
+#include <utility>
+
+#include "cpu/simple_thread.hh"
+#include "params/BranchTraceProbe.hh"
+#include "proto/protoio.hh"
+#include "sim/probe/branch.hh"
+#include "sim/probe/probe.hh"
+
+/**
+ * Records the control instructions committed by a CPU as a protobuf
+ * branch trace (see proto/branch.proto). BranchTraceReplay plays such a
+ * trace back through any number of branch predictors without simulating
+ * a CPU.
+ */
+class BranchTraceProbe : public ProbeListenerObject
+{
+  public:
+    BranchTraceProbe(const BranchTraceProbeParams *params);
+
+    void regProbeListeners() override;
+
+    void startup() override;
+
+  private:
+    /** Count a committed instruction, macro-ops counting once */
+    void countInst(const std::pair<SimpleThread*, const StaticInstPtr> &p);
+
+    /** Append a committed control instruction to the trace */
+    void recordBranch(const ProbePoints::BranchInfo &branch);
+
+    void closeStreams();
+
+    ProtoOutputStream *traceStream;
+
+    /** Instructions committed since the last branch was recorded */
+    uint32_t instsSinceBranch;
+};
+
+#endif // __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
@@ -37,7 +37,12 @@
 
 #include "cpu/simple/probes/simpoint.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "base/output.hh"
+#include "sim/core.hh"
 
 SimPoint::SimPoint(const SimPointParams *p)
     : ProbeListenerObject(p),
@@ -46,11 +51,31 @@ SimPoint::SimPoint(const SimPointParams *p)
       intervalDrift(0),
       simpointStream(NULL),
       currentBBV(0, 0),
-      currentBBVInstCount(0)
+      currentBBVInstCount(0),
+      maxK(p->max_k),
+      numDims(p->projection_dims),
+      numInits(p->kmeans_inits),
+      maxIters(p->kmeans_iters),
+      bicThreshold(p->bic_threshold),
+      simpointFile(p->simpoint_file),
+      weightFile(p->weight_file),
+      tickFile(p->tick_file),
+      projectionRng(p->projection_seed),
+      kmeansRng(p->kmeans_seed),
+      intervalStart(0)
 {
     simpointStream = simout.create(p->profile_file, false);
     if (!simpointStream)
         fatal("unable to open SimPoint profile_file");
+
+    fatal_if(maxK && !numDims, "SimPoint needs at least one projection "
+             "dimension to pick simulation points");
+
+    for (auto &entry : bbCache)
+        entry.id = 0;
+
+    if (maxK)
+        registerExitCallback([this]() { pickSimPoints(); });
 }
 
 SimPoint::~SimPoint()
@@ -65,10 +90,44 @@ SimPoint::init()
 void
 SimPoint::regProbeListeners()
 {
-    typedef ProbeListenerArg<SimPoint, std::pair<SimpleThread*,StaticInstPtr>>
+    typedef ProbeListenerMethod<SimPoint,
+                                std::pair<SimpleThread*, StaticInstPtr>,
+                                &SimPoint::profile>
         SimPointListener;
-    listeners.push_back(new SimPointListener(this, "Commit",
-                                             &SimPoint::profile));
+    listeners.push_back(new SimPointListener(this, "Commit"));
+}
+
+uint32_t
+SimPoint::lookupBB()
+{
+    const Addr end = currentBBV.second;
+    BBCacheEntry &entry = bbCache[(end ^ (end >> 10)) % bbCache.size()];
+    if (entry.id && entry.range == currentBBV)
+        return entry.id;
+
+    auto map_itr = bbMap.find(currentBBV);
+    if (map_itr == bbMap.end()) {
+        // If a new (previously unseen) basic block is found,
+        // add a new unique id, record num of insts and insert
+        // into bbMap.
+        BBInfo info;
+        info.id = bbInfo.size() + 1;
+        info.insts = currentBBVInstCount;
+        info.count = 0;
+        bbInfo.push_back(info);
+        map_itr = bbMap.insert(std::make_pair(currentBBV, info.id)).first;
+
+        // Each block gets its own random projection vector
+        if (maxK) {
+            std::uniform_real_distribution<double> dist(-1.0, 1.0);
+            for (unsigned d = 0; d < numDims; ++d)
+                projection.push_back(dist(projectionRng));
+        }
+    }
+
+    entry.range = currentBBV;
+    entry.id = map_itr->second;
+    return entry.id;
 }
 
 void
@@ -90,53 +149,245 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
     if (inst->isControl()) {
         currentBBV.second = thread->pcState().instAddr();
 
-        auto map_itr = bbMap.find(currentBBV);
-        if (map_itr == bbMap.end()){
-            // If a new (previously unseen) basic block is found,
-            // add a new unique id, record num of insts and insert
-            // into bbMap.
-            BBInfo info;
-            info.id = bbMap.size() + 1;
-            info.insts = currentBBVInstCount;
-            info.count = currentBBVInstCount;
-            bbMap.insert(std::make_pair(currentBBV, info));
-        } else {
-            // If basic block is seen before, just increment the count by the
-            // number of insts in basic block.
-            BBInfo& info = map_itr->second;
-            info.count += currentBBVInstCount;
-        }
+        // Increment the count of the block by the number of insts in
+        // the basic block, and remember that the block was executed in
+        // this interval
+        const uint32_t id = lookupBB();
+        BBInfo& info = bbInfo[id - 1];
+        if (!info.count)
+            activeBBs.push_back(id);
+        info.count += currentBBVInstCount;
         currentBBVInstCount = 0;
 
         // Reached end of interval if the sum of the current inst count
         // (intervalCount) and the excessive inst count from the previous
         // interval (intervalDrift) is greater than/equal to the interval size.
         if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
+            endInterval();
+            intervalDrift = (intervalCount + intervalDrift) - intervalSize;
+            intervalCount = 0;
+        }
+    }
+}
+
+void
+SimPoint::endInterval()
+{
+    // summarize interval and display BBV info
+    std::sort(activeBBs.begin(), activeBBs.end());
+
+    uint64_t total = 0;
+    *simpointStream->stream() << "T";
+    for (auto id : activeBBs) {
+        const BBInfo& info = bbInfo[id - 1];
+        *simpointStream->stream() << ":" << id << ":" << info.count << " ";
+        total += info.count;
+    }
+    *simpointStream->stream() << "\n";
+
+    // Project the BBV, normalised to the interval length, down to a few
+    // dimensions for the clustering
+    if (maxK) {
+        const size_t base = points.size();
+        points.resize(base + numDims, 0.0);
+        for (auto id : activeBBs) {
+            const double weight = double(bbInfo[id - 1].count) / total;
+            const double *row = &projection[(id - 1) * numDims];
+            for (unsigned d = 0; d < numDims; ++d)
+                points[base + d] += weight * row[d];
+        }
+        intervalTicks.push_back(intervalStart);
+        intervalStart = curTick();
+    }
+
+    for (auto id : activeBBs)
+        bbInfo[id - 1].count = 0;
+    activeBBs.clear();
+}
+
+double
+SimPoint::distance(size_t i, const double *point) const
+{
+    double dist = 0;
+    for (unsigned d = 0; d < numDims; ++d) {
+        const double diff = points[i * numDims + d] - point[d];
+        dist += diff * diff;
+    }
+    return dist;
+}
+
+double
+SimPoint::kmeans(unsigned k, std::vector<unsigned> &assign,
+                 std::vector<double> &centers)
+{
+    const size_t n = intervalTicks.size();
+
+    // Start from k distinct random intervals
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), kmeansRng);
+    centers.resize(k * numDims);
+    for (unsigned c = 0; c < k; ++c) {
+        std::copy(&points[order[c] * numDims],
+                  &points[order[c] * numDims] + numDims,
+                  &centers[c * numDims]);
+    }
+
+    assign.assign(n, k);
+    std::vector<size_t> sizes(k);
+    double distortion = 0;
+    for (unsigned iter = 0; iter < maxIters; ++iter) {
+        // Assign every interval to its closest center
+        bool changed = false;
+        distortion = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned best = 0;
+            double best_dist = std::numeric_limits<double>::max();
+            for (unsigned c = 0; c < k; ++c) {
+                const double dist = distance(i, &centers[c * numDims]);
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    best = c;
                 }
             }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
+            changed |= assign[i] != best;
+            assign[i] = best;
+            distortion += best_dist;
+        }
+        if (!changed)
+            break;
+
+        // Move the centers to the mean of their intervals, leaving the
+        // center of an empty cluster where it is
+        std::vector<double> sums(k * numDims, 0.0);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            ++sizes[assign[i]];
+            for (unsigned d = 0; d < numDims; ++d)
+                sums[assign[i] * numDims + d] += points[i * numDims + d];
+        }
+        for (unsigned c = 0; c < k; ++c) {
+            if (!sizes[c])
+                continue;
+            for (unsigned d = 0; d < numDims; ++d)
+                centers[c * numDims + d] = sums[c * numDims + d] / sizes[c];
+        }
+    }
+
+    return distortion;
+}
+
+double
+SimPoint::bic(unsigned k, const std::vector<unsigned> &assign,
+              double distortion) const
+{
+    // The score of the SimPoint tool, after Pelleg and Moore's X-means
+    const double r = assign.size();
+    const double m = numDims;
+    if (r <= k)
+        return 0;
+
+    std::vector<double> sizes(k, 0.0);
+    for (auto c : assign)
+        sizes[c] += 1;
+
+    // Use a tiny variance for a perfect fit to keep the log finite
+    const double variance =
+        std::max(distortion / (r - k), std::numeric_limits<double>::min());
+    double likelihood = 0;
+    for (auto size : sizes) {
+        if (!size)
+            continue;
+        likelihood += -size / 2 * std::log(2 * M_PI) -
+            size * m / 2 * std::log(variance) - (size - k) / 2 +
+            size * std::log(size) - size * std::log(r);
+    }
+
+    const double params = (k - 1) + m * k + 1;
+    return likelihood - params / 2 * std::log(r);
+}
+
+void
+SimPoint::pickSimPoints()
+{
+    const size_t n = intervalTicks.size();
+    if (!n) {
+        warn("SimPoint: no complete interval, not picking simulation "
+             "points\n");
+        return;
+    }
+
+    // Cluster with every k up to the maximum, keeping the best of a few
+    // random initialisations for each
+    const unsigned max_k = std::min<size_t>(maxK, n);
+    std::vector<std::vector<unsigned>> assigns(max_k + 1);
+    std::vector<std::vector<double>> centers(max_k + 1);
+    std::vector<double> scores(max_k + 1);
+    for (unsigned k = 1; k <= max_k; ++k) {
+        double best = std::numeric_limits<double>::max();
+        for (unsigned init = 0; init < std::max(numInits, 1u); ++init) {
+            std::vector<unsigned> assign;
+            std::vector<double> center;
+            const double distortion = kmeans(k, assign, center);
+            if (distortion < best) {
+                best = distortion;
+                assigns[k].swap(assign);
+                centers[k].swap(center);
             }
-            *simpointStream->stream() << "\n";
+        }
+        scores[k] = bic(k, assigns[k], best);
+    }
 
-            intervalDrift = (intervalCount + intervalDrift) - intervalSize;
-            intervalCount = 0;
+    // Pick the smallest k that scores at least the threshold fraction
+    // of the way from the worst to the best score
+    const auto minmax = std::minmax_element(scores.begin() + 1,
+                                            scores.end());
+    const double target = *minmax.first +
+        bicThreshold * (*minmax.second - *minmax.first);
+    unsigned k = 1;
+    while (k < max_k && scores[k] < target)
+        ++k;
+
+    // Represent each cluster by the interval closest to its center, and
+    // weigh it by the fraction of intervals in the cluster
+    std::vector<size_t> rep(k, n);
+    std::vector<double> rep_dist(k, std::numeric_limits<double>::max());
+    std::vector<size_t> sizes(k, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned c = assigns[k][i];
+        const double dist = distance(i, &centers[k][c * numDims]);
+        ++sizes[c];
+        if (dist < rep_dist[c]) {
+            rep_dist[c] = dist;
+            rep[c] = i;
         }
     }
+
+    OutputStream *simpoints = simout.create(simpointFile, false);
+    OutputStream *weights = simout.create(weightFile, false);
+    OutputStream *ticks = simout.create(tickFile, false);
+    fatal_if(!simpoints || !weights || !ticks,
+             "unable to open SimPoint output files");
+
+    unsigned id = 0;
+    for (unsigned c = 0; c < k; ++c) {
+        if (!sizes[c])
+            continue;
+        const double weight = double(sizes[c]) / n;
+        *simpoints->stream() << rep[c] << " " << id << "\n";
+        *weights->stream() << weight << " " << id << "\n";
+        *ticks->stream() << intervalTicks[rep[c]] << " " << rep[c] << " "
+                         << weight << "\n";
+        ++id;
+    }
+
+    simout.close(simpoints);
+    simout.close(weights);
+    simout.close(ticks);
+
+    inform("SimPoint: picked %d simulation points from %d intervals\n",
+           id, n);
 }
 
 /** SimPoint SimObject */
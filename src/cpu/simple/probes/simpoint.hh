@@ -38,7 +38,10 @@
 #ifndef __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
+#include <array>
+#include <random>
 #include <unordered_map>
+#include <vector>
 
 #include "base/output.hh"
 #include "cpu/simple_thread.hh"
@@ -87,6 +90,42 @@ class SimPoint : public ProbeListenerObject
     void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
 
   private:
+    /**
+     * Look up the id of the current basic block, assigning a new one if
+     * the block has not been seen before.
+     */
+    uint32_t lookupBB();
+
+    /** Write out the BBV of the interval that just ended */
+    void endInterval();
+
+    /**
+     * Cluster the projected BBVs of all intervals and write out the
+     * chosen simulation points, in the same way as the SimPoint tool.
+     */
+    void pickSimPoints();
+
+    /**
+     * Run k-means clustering on the projected BBVs.
+     *
+     * @param k Number of clusters
+     * @param assign Cluster of each interval
+     * @param centers Centers of the clusters
+     * @return Sum of the squared distances to the cluster centers
+     */
+    double kmeans(unsigned k, std::vector<unsigned> &assign,
+                  std::vector<double> &centers);
+
+    /**
+     * Bayesian Information Criterion of a clustering, as used by the
+     * SimPoint tool to choose the number of clusters.
+     */
+    double bic(unsigned k, const std::vector<unsigned> &assign,
+               double distortion) const;
+
+    /** Squared distance of interval i to a point */
+    double distance(size_t i, const double *point) const;
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
@@ -107,12 +146,60 @@ class SimPoint : public ProbeListenerObject
         uint64_t count;
     };
 
-    /** Hash table containing all previously seen basic blocks */
-    std::unordered_map<BasicBlockRange, BBInfo> bbMap;
+    /**
+     * Information of all previously seen basic blocks, indexed by
+     * their id minus one. Ids are assigned in order of first sight.
+     */
+    std::vector<BBInfo> bbInfo;
+    /** Hash table from basic block to id */
+    std::unordered_map<BasicBlockRange, uint32_t> bbMap;
+
+    /** Entry of the direct-mapped basic block lookup cache */
+    struct BBCacheEntry {
+        BasicBlockRange range;
+        /** Id of the block, 0 if the entry is invalid */
+        uint32_t id;
+    };
+    /**
+     * Small cache in front of bbMap, indexed by the address of the last
+     * inst of a block, which catches the hot blocks.
+     */
+    std::array<BBCacheEntry, 1024> bbCache;
+
+    /** Ids of the blocks executed in the current interval */
+    std::vector<uint32_t> activeBBs;
     /** Currently executing basic block */
     BasicBlockRange currentBBV;
     /** inst count in current basic block */
     uint64_t currentBBVInstCount;
+
+    /** Maximum number of clusters, 0 if not clustering */
+    const unsigned maxK;
+    /** Number of dimensions the BBVs are projected down to */
+    const unsigned numDims;
+    /** Number of random initialisations tried for each k */
+    const unsigned numInits;
+    /** Maximum number of k-means iterations */
+    const unsigned maxIters;
+    /** Fraction of the BIC range a clustering must reach */
+    const double bicThreshold;
+    /** Output files for the simulation points, weights and ticks */
+    const std::string simpointFile;
+    const std::string weightFile;
+    const std::string tickFile;
+
+    /** Random generator for the projection */
+    std::mt19937_64 projectionRng;
+    /** Random generator for the k-means initialisation */
+    std::mt19937_64 kmeansRng;
+    /** Projection matrix, numDims values per basic block */
+    std::vector<double> projection;
+    /** Projected and normalised BBV of each interval, numDims each */
+    std::vector<double> points;
+    /** Tick at which each interval starts */
+    std::vector<Tick> intervalTicks;
+    /** Tick at which the current interval started */
+    Tick intervalStart;
 };
 
 #endif // __CPU_SIMPLE_PROBES_SIMPOINT_HH__
@@ -875,7 +875,7 @@ TimingSimpleCPU::completeIfetch(PacketPtr pkt)
         }
     } else if (curStaticInst) {
         // non-memory instruction: execute completely now
-        Fault fault = curStaticInst->execute(&t_info, traceData);
+        Fault fault = curStaticInst->executeSimple(&t_info, traceData);
 
         // keep an instruction count
         if (fault == NoFault)
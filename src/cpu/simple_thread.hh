@@ -86,7 +86,7 @@ class CheckerCPU;
  * examples.
  */
 
-class SimpleThread : public ThreadState, public ThreadContext
+class SimpleThread final : public ThreadState, public ThreadContext
 {
   protected:
     typedef TheISA::MachInst MachInst;
@@ -52,6 +52,7 @@
 #include "base/refcnt.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
+#include "config/use_simple_exec.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
 #include "cpu/static_inst_fwd.hh"
@@ -63,6 +64,7 @@
 class Packet;
 
 class ExecContext;
+class SimpleExecContext;
 
 namespace Loader
 {
@@ -287,6 +289,17 @@ class StaticInst : public RefCounted, public StaticInstFlags
     virtual Fault execute(ExecContext *xc,
                           Trace::InstRecord *traceData) const = 0;
 
+#if USE_SIMPLE_EXEC
+    /**
+     * Execute the instruction in one of the simple CPUs. The ISA parser
+     * overrides this with a copy of execute() in which the accesses to
+     * the (final) SimpleExecContext are resolved statically; the default,
+     * defined with the simple CPUs, just calls execute().
+     */
+    virtual Fault executeSimple(SimpleExecContext *xc,
+                                Trace::InstRecord *traceData) const;
+#endif
+
     virtual Fault initiateAcc(ExecContext *xc,
                               Trace::InstRecord *traceData) const
     {
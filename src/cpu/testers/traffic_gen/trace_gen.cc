@@ -45,19 +45,27 @@
 #include "proto/packet.pb.h"
 
 TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
 {
+    if (BinPacketTrace::isBinTrace(filename))
+        binTrace.reset(new BinPacketTraceReader(filename));
+    else
+        trace.reset(new ProtoInputStream(filename));
     init();
 }
 
 void
 TraceGen::InputStream::init()
 {
-    // Create a protobuf message for the header and read it from the stream
+    // Create a protobuf message for the header and read it from the
+    // stream, binary traces have read theirs already
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (binTrace) {
+        header_msg = binTrace->header();
+    } else if (!trace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
-    } else if (header_msg.tick_freq() != SimClock::Frequency) {
+    }
+
+    if (header_msg.tick_freq() != SimClock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
               header_msg.tick_freq());
     }
@@ -66,15 +74,30 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (binTrace)
+        binTrace->reset();
+    else
+        trace->reset();
     init();
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (binTrace) {
+        BinPacketRecord record;
+        if (!binTrace->read(record))
+            return false;
+        element.cmd = record.cmd;
+        element.addr = record.addr;
+        element.blocksize = record.size;
+        element.tick = record.tick;
+        element.flags = record.flags;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
@@ -44,10 +44,13 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
 #include "mem/packet.hh"
+#include "proto/bin_packet_trace.hh"
 #include "proto/protoio.hh"
 
 /**
@@ -100,7 +103,8 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. Both protobuf and binary packet traces are
+     * supported.
      */
     class InputStream
     {
@@ -108,7 +112,10 @@ class TraceGen : public BaseGen
       private:
 
         /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        std::unique_ptr<ProtoInputStream> trace;
+
+        /// Reader used instead if the trace is a binary packet trace
+        std::unique_ptr<BinPacketTraceReader> binTrace;
 
       public:
 
@@ -46,11 +46,26 @@ class TimeBuffer
     std::vector<char *> index;
     unsigned base;
 
+    /** Slots which have been advanced into the future end of the buffer
+     *  but not yet cleared.  Clearing is deferred until a slot is next
+     *  accessed so that advance() does a constant amount of work however
+     *  large T is, and slots which are never accessed are never cleared */
+    mutable std::vector<bool> stale;
+
     void valid(int idx) const
     {
         assert (idx >= -past && idx <= future);
     }
 
+    /** Return a slot to the state of a newly constructed, zero-filled T */
+    void clear(unsigned vector_index) const
+    {
+        (reinterpret_cast<T *>(index[vector_index]))->~T();
+        std::memset(index[vector_index], 0, sizeof(T));
+        new (index[vector_index]) T;
+        stale[vector_index] = false;
+    }
+
   public:
     friend class wire;
     class wire
@@ -136,7 +151,8 @@ class TimeBuffer
   public:
     TimeBuffer(int p, int f)
         : past(p), future(f), size(past + future + 1),
-          data(new char[size * sizeof(T)]), index(size), base(0)
+          data(new char[size * sizeof(T)]), index(size), base(0),
+          stale(size, false)
     {
         assert(past >= 0 && future >= 0);
         char *ptr = data;
@@ -181,9 +197,7 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
-        (reinterpret_cast<T *>(index[ptr]))->~T();
-        std::memset(index[ptr], 0, sizeof(T));
-        new (index[ptr]) T;
+        stale[ptr] = true;
     }
 
   protected:
@@ -204,26 +218,32 @@ class TimeBuffer
         return vector_index;
     }
 
-  public:
-    T *access(int idx)
+    //Find the storage for the element at position idx relative to now,
+    //clearing it first if it has gone stale
+    inline char *slot(int idx) const
     {
         int vector_index = calculateVectorIndex(idx);
 
-        return reinterpret_cast<T *>(index[vector_index]);
+        if (stale[vector_index])
+            clear(vector_index);
+
+        return index[vector_index];
     }
 
-    T &operator[](int idx)
+  public:
+    T *access(int idx)
     {
-        int vector_index = calculateVectorIndex(idx);
+        return reinterpret_cast<T *>(slot(idx));
+    }
 
-        return reinterpret_cast<T &>(*index[vector_index]);
+    T &operator[](int idx)
+    {
+        return reinterpret_cast<T &>(*slot(idx));
     }
 
     const T &operator[] (int idx) const
     {
-        int vector_index = calculateVectorIndex(idx);
-
-        return reinterpret_cast<const T &>(*index[vector_index]);
+        return reinterpret_cast<const T &>(*slot(idx));
     }
 
     wire getWire(int idx)
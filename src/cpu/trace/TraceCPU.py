@@ -83,3 +83,9 @@ class TraceCPU(BaseCPU):
     progressMsgInterval = Param.Unsigned(0, "Interval of committed "\
                                          "instructions at which to print a"\
                                          " progress msg")
+
+    # If a cache directory is given, the traces are decoded once into a
+    # binary cache file in that directory, which is memory mapped by later
+    # runs replaying the same traces instead of parsing them again.
+    traceCacheDir = Param.String("", "Directory to cache decoded traces "\
+                                 "in, empty to disable the cache")
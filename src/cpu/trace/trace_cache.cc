@@ -0,0 +1,179 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/trace_cache.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+#include "base/logging.hh"
+
+namespace
+{
+
+/** Amount of the trace contents that goes into the key */
+const size_t keyContentsSize = 64 * 1024;
+
+/** FNV-1a hash, accumulating into hash */
+uint64_t
+fnv1a(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+TraceCache::TraceCache(const std::string& dir, const std::string& trace_file,
+                       const std::string& format, size_t record_size)
+    : key(0xcbf29ce484222325ULL), recordSize(record_size), numRecords(0),
+      mapBase(nullptr), mapSize(0), records(nullptr)
+{
+    struct stat st_buf;
+    if (stat(trace_file.c_str(), &st_buf) != 0)
+        fatal("Could not stat trace %s\n", trace_file);
+
+    const uint64_t file_size = st_buf.st_size;
+    const uint64_t mod_time = st_buf.st_mtime;
+    key = fnv1a(key, trace_file.data(), trace_file.size());
+    key = fnv1a(key, &file_size, sizeof(file_size));
+    key = fnv1a(key, &mod_time, sizeof(mod_time));
+    key = fnv1a(key, format.data(), format.size());
+    key = fnv1a(key, &record_size, sizeof(record_size));
+
+    std::ifstream trace(trace_file, std::ios::in | std::ios::binary);
+    std::string contents(keyContentsSize, '\0');
+    trace.read(&contents[0], contents.size());
+    key = fnv1a(key, contents.data(), trace.gcount());
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    fileName = dir + "/" + format + "-" + name + ".bin";
+    tmpName = fileName + ".tmp." + std::to_string(getpid());
+}
+
+TraceCache::~TraceCache()
+{
+    unmap();
+    if (out.is_open()) {
+        out.close();
+        std::remove(tmpName.c_str());
+    }
+}
+
+bool
+TraceCache::map()
+{
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st_buf;
+    if (fstat(fd, &st_buf) != 0 ||
+        (size_t)st_buf.st_size < sizeof(FileHeader)) {
+        close(fd);
+        return false;
+    }
+
+    mapSize = st_buf.st_size;
+    mapBase = mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapBase == MAP_FAILED) {
+        mapBase = nullptr;
+        return false;
+    }
+
+    const FileHeader* header = static_cast<const FileHeader*>(mapBase);
+    if (header->magic != magicNumber || header->key != key ||
+        header->recordSize != recordSize ||
+        mapSize != sizeof(FileHeader) + header->numRecords * recordSize) {
+        warn("Ignoring invalid trace cache %s\n", fileName);
+        unmap();
+        return false;
+    }
+
+    numRecords = header->numRecords;
+    records = static_cast<const uint8_t*>(mapBase) + sizeof(FileHeader);
+    return true;
+}
+
+void
+TraceCache::beginWrite()
+{
+    unmap();
+    out.open(tmpName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good())
+        fatal("Could not open %s for writing\n", tmpName);
+
+    // The header is completed once all records are written
+    FileHeader header = { magicNumber, key, recordSize, 0 };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    numRecords = 0;
+}
+
+void
+TraceCache::append(const void* record)
+{
+    out.write(static_cast<const char*>(record), recordSize);
+    ++numRecords;
+}
+
+void
+TraceCache::endWrite()
+{
+    FileHeader header = { magicNumber, key, recordSize, numRecords };
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (out.fail())
+        fatal("Failed to write trace cache %s\n", tmpName);
+
+    // Publish the complete file; an identical file written concurrently
+    // by another simulation is simply replaced
+    if (std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+        fatal("Could not rename %s to %s\n", tmpName, fileName);
+
+    if (!map())
+        fatal("Could not map trace cache %s\n", fileName);
+}
+
+void
+TraceCache::unmap()
+{
+    if (mapBase)
+        munmap(mapBase, mapSize);
+    mapBase = nullptr;
+    mapSize = 0;
+    records = nullptr;
+    numRecords = 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TRACE_TRACE_CACHE_HH__
+#define __CPU_TRACE_TRACE_CACHE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * A TraceCache keeps the decoded records of a protobuf trace in a file
+ * as a flat array of fixed-size structs. The file is built the first
+ * time a trace is replayed, and later replays memory map it and use the
+ * records in place instead of decompressing and parsing the trace
+ * again. Simulations sharing a cache directory also share the pages of
+ * the mapping.
+ *
+ * Cache files are named after a key made from the trace path, size,
+ * modification time and the start of its contents, together with the
+ * record format and size, so a changed trace or a different record
+ * layout never picks up a stale cache. Files are written under a
+ * temporary name and renamed once complete, so concurrent simulations
+ * building the same cache never see a partial file.
+ */
+class TraceCache
+{
+  public:
+    /**
+     * @param dir Directory holding the cache files
+     * @param trace_file Path of the protobuf trace being cached
+     * @param format Name of the record format
+     * @param record_size Size of a record in bytes
+     */
+    TraceCache(const std::string& dir, const std::string& trace_file,
+               const std::string& format, size_t record_size);
+
+    ~TraceCache();
+
+    /**
+     * Map the cache file if a valid one exists.
+     *
+     * @return true if the records are available
+     */
+    bool map();
+
+    /** Start building the cache file */
+    void beginWrite();
+
+    /** Add a record to the cache file being built */
+    void append(const void* record);
+
+    /** Complete the cache file and map it */
+    void endWrite();
+
+    /** Number of records in the mapped cache */
+    size_t size() const { return numRecords; }
+
+    /** Get a record from the mapped cache */
+    template <class Record>
+    const Record&
+    get(size_t idx) const
+    {
+        return reinterpret_cast<const Record*>(records)[idx];
+    }
+
+    /** Path of the cache file */
+    const std::string& path() const { return fileName; }
+
+  private:
+    /** Header at the start of a cache file */
+    struct FileHeader
+    {
+        uint64_t magic;
+        uint64_t key;
+        uint64_t recordSize;
+        uint64_t numRecords;
+    };
+
+    /** Ascii "gem5trc" followed by a format version */
+    static const uint64_t magicNumber = 0x01637274356d6567ULL;
+
+    /** Drop the mapping, if any */
+    void unmap();
+
+    /** Key of the trace and record format */
+    uint64_t key;
+
+    /** Size of a record in bytes */
+    const size_t recordSize;
+
+    /** Path of the cache file and of the file being built */
+    std::string fileName;
+    std::string tmpName;
+
+    /** Stream used while building the cache file */
+    std::ofstream out;
+
+    /** Number of records in the cache */
+    size_t numRecords;
+
+    /** The mapping of the whole file and the records within it */
+    void* mapBase;
+    size_t mapSize;
+    const uint8_t* records;
+};
+
+#endif // __CPU_TRACE_TRACE_CACHE_HH__
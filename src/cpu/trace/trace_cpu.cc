@@ -37,6 +37,10 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <algorithm>
+#include <cstring>
+
+#include "base/intmath.hh"
 #include "sim/sim_exit.hh"
 
 // Declare and initialize the static counter for number of trace CPUs.
@@ -50,7 +54,8 @@ TraceCPU::TraceCPU(TraceCPUParams *params)
         dataRequestorID(params->system->getRequestorId(this, "data")),
         instTraceFile(params->instTraceFile),
         dataTraceFile(params->dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params->traceCacheDir),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -260,19 +265,17 @@ TraceCPU::ElasticDataGen::init()
     if (DTRACE(TraceCPUData)) {
         printReadyList();
     }
-    auto free_itr = readyList.begin();
+    const ReadyNode& free_node = readyList.front();
     DPRINTF(TraceCPUData, "Execute tick of the first dependency free node %lli"
-            " is %d.\n", free_itr->seqNum, free_itr->execTick);
+            " is %d.\n", free_node.seqNum, free_node.execTick);
     // Return the execute tick of the earliest ready node so that an event
     // can be scheduled to call execute()
-    return (free_itr->execTick);
+    return (free_node.execTick);
 }
 
 void
 TraceCPU::ElasticDataGen::adjustInitTraceOffset(Tick& offset) {
-    for (auto& free_node : readyList) {
-        free_node.execTick -= offset;
-    }
+    readyList.adjustExecTicks(offset);
 }
 
 void
@@ -300,14 +303,15 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
+        // Get a new graph node
+        GraphNode* new_node = depGraph.allocate();
 
         // Read the next line to get the next record. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
         // to returning false.
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
+            depGraph.recycle(new_node);
             traceComplete = true;
             return false;
         }
@@ -319,8 +323,8 @@ TraceCPU::ElasticDataGen::readNextWindow()
         addDepsOnParent(new_node, new_node->regDep, new_node->numRegDep);
 
         num_read++;
-        // Add to map
-        depGraph[new_node->seqNum] = new_node;
+        // Add to graph
+        depGraph.insert(new_node);
         if (new_node->numRobDep == 0 && new_node->numRegDep == 0) {
             // Source dependencies are already complete, check if resources
             // are available and issue. The execution time is approximated
@@ -346,13 +350,13 @@ TraceCPU::ElasticDataGen::addDepsOnParent(GraphNode *new_node,
         if (a_dep == 0)
             break;
         // We look up the valid dependency, i.e. the parent of this node
-        auto parent_itr = depGraph.find(a_dep);
-        if (parent_itr != depGraph.end()) {
+        GraphNode* parent = depGraph.find(a_dep);
+        if (parent) {
             // If the parent is found, it is yet to be executed. Append a
             // pointer to the new node to the dependents list of the parent
             // node.
-            parent_itr->second->dependents.push_back(new_node);
-            auto num_depts = parent_itr->second->dependents.size();
+            parent->dependents.push_back(new_node);
+            auto num_depts = parent->dependents.size();
             elasticStats.maxDependents = std::max<double>(num_depts,
                                         elasticStats.maxDependents.value());
         } else {
@@ -394,16 +398,13 @@ TraceCPU::ElasticDataGen::execute()
         }
     }
     // Proceed to execute from readyList
-    auto graph_itr = depGraph.begin();
-    auto free_itr = readyList.begin();
     // Iterate through readyList until the next free node has its execute
     // tick later than curTick or the end of readyList is reached
-    while (free_itr->execTick <= curTick() && free_itr != readyList.end()) {
+    while (!readyList.empty() && readyList.front().execTick <= curTick()) {
 
         // Get pointer to the node to be executed
-        graph_itr = depGraph.find(free_itr->seqNum);
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = depGraph.find(readyList.front().seqNum);
+        assert(node_ptr);
 
         // If there is a retryPkt send that else execute the load
         if (retryPkt) {
@@ -427,8 +428,10 @@ TraceCPU::ElasticDataGen::execute()
         }
         // If the retryPkt or a new load/store node failed, we exit from here
         // as a retry from cache will bring the control to execute(). The
-        // first node in readyList then, will be the failed node.
+        // first node in readyList then, will be the failed node, and it
+        // keeps its place until it is sent.
         if (retryPkt) {
+            readyList.pinFront();
             break;
         }
 
@@ -486,7 +489,7 @@ TraceCPU::ElasticDataGen::execute()
         }
 
         // After executing the node, remove from readyList and delete node.
-        readyList.erase(free_itr);
+        readyList.pop();
         // If it is a cacheable load which was sent, don't delete
         // just yet.  Delete it in completeMemAccess() after the
         // response is received. If it is an strictly ordered
@@ -501,13 +504,9 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
-            // delete node
-            delete node_ptr;
-            // remove from graph
-            depGraph.erase(graph_itr);
+            // remove from graph and recycle the node
+            depGraph.erase(node_ptr);
         }
-        // Point to first node to continue to next iteration of while loop
-        free_itr = readyList.begin();
     } // end of while loop
 
     // Print readyList, sizes of queues and resource status after updating
@@ -537,7 +536,7 @@ TraceCPU::ElasticDataGen::execute()
     // list is empty then check if the next pending node has resources
     // available to issue. If yes, then schedule an event for the next cycle.
     if (!readyList.empty()) {
-        Tick next_event_tick = std::max(readyList.begin()->execTick,
+        Tick next_event_tick = std::max(readyList.front().execTick,
                                         curTick());
         DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
                 next_event_tick);
@@ -690,9 +689,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
     } else {
         // If it is a load response then release the dependents waiting on it.
         // Get pointer to the completed load
-        auto graph_itr = depGraph.find(pkt->req->getReqInstSeqNum());
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = depGraph.find(pkt->req->getReqInstSeqNum());
+        assert(node_ptr);
 
         // Release resources occupied by the load
         hwResource.release(node_ptr);
@@ -710,10 +708,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
-        // delete node
-        delete node_ptr;
-        // remove from graph
-        depGraph.erase(graph_itr);
+        // remove from graph and recycle the node
+        depGraph.erase(node_ptr);
     }
 
     if (DTRACE(TraceCPUData)) {
@@ -736,7 +732,7 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         // are pending nodes in the depFreeQueue. The checking is done in the
         // execute() control flow, so schedule an event to go via that flow.
         Tick next_event_tick = readyList.empty() ? owner.clockEdge(Cycles(1)) :
-            std::max(readyList.begin()->execTick, owner.clockEdge(Cycles(1)));
+            std::max(readyList.front().execTick, owner.clockEdge(Cycles(1)));
         DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
                 next_event_tick);
         owner.schedDcacheNextEvent(next_event_tick);
@@ -751,50 +747,11 @@ TraceCPU::ElasticDataGen::addToSortedReadyList(NodeSeqNum seq_num,
     ready_node.seqNum = seq_num;
     ready_node.execTick = exec_tick;
 
-    // Iterator to readyList
-    auto itr = readyList.begin();
-
-    // If the readyList is empty, simply insert the new node at the beginning
-    // and return
-    if (itr == readyList.end()) {
-        readyList.insert(itr, ready_node);
-        elasticStats.maxReadyListSize = std::max<double>(readyList.size(),
-                                        elasticStats.maxReadyListSize.value());
-        return;
-    }
-
-    // If the new node has its execution tick equal to the first node in the
-    // list then go to the next node. If the first node in the list failed
-    // to execute, its position as the first is thus maintained.
-    if (retryPkt)
-        if (retryPkt->req->getReqInstSeqNum() == itr->seqNum)
-            itr++;
-
-    // Increment the iterator and compare the node pointed to by it to the new
-    // node till the position to insert the new node is found.
-    bool found = false;
-    while (!found && itr != readyList.end()) {
-        // If the execution tick of the new node is less than the node then
-        // this is the position to insert
-        if (exec_tick < itr->execTick)
-            found = true;
-        // If the execution tick of the new node is equal to the node then
-        // sort in ascending order of sequence numbers
-        else if (exec_tick == itr->execTick) {
-            // If the sequence number of the new node is less than the node
-            // then this is the position to insert
-            if (seq_num < itr->seqNum)
-                found = true;
-            // Else go to next node
-            else
-                itr++;
-        }
-        // If the execution tick of the new node is greater than the node then
-        // go to the next node
-        else
-            itr++;
-    }
-    readyList.insert(itr, ready_node);
+    // Nodes are ordered by execution tick, and nodes with equal execution
+    // ticks in ascending order of sequence numbers. If the first node
+    // failed to execute, its position as the first is maintained by the
+    // queue.
+    readyList.push(ready_node);
     // Update the stat for max size reached of the readyList
     elasticStats.maxReadyListSize = std::max<double>(readyList.size(),
                                         elasticStats.maxReadyListSize.value());
@@ -803,19 +760,127 @@ TraceCPU::ElasticDataGen::addToSortedReadyList(NodeSeqNum seq_num,
 void
 TraceCPU::ElasticDataGen::printReadyList() {
 
-    auto itr = readyList.begin();
-    if (itr == readyList.end()) {
+    if (readyList.empty()) {
         DPRINTF(TraceCPUData, "readyList is empty.\n");
         return;
     }
     DPRINTF(TraceCPUData, "Printing readyList:\n");
-    while (itr != readyList.end()) {
-        auto graph_itr = depGraph.find(itr->seqNum);
-        GraphNode* node_ptr M5_VAR_USED = graph_itr->second;
-        DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", itr->seqNum,
-            node_ptr->typeToStr(), itr->execTick);
-        itr++;
+    for (const auto& ready_node : readyList.sorted()) {
+        GraphNode* node_ptr M5_VAR_USED = depGraph.find(ready_node.seqNum);
+        DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", ready_node.seqNum,
+            node_ptr->typeToStr(), ready_node.execTick);
+    }
+}
+
+TraceCPU::ElasticDataGen::DepGraph::DepGraph(uint32_t window_size)
+    : ring(1ULL << ceilLog2(2 * std::max<uint64_t>(window_size, 1)),
+           nullptr),
+      mask(ring.size() - 1),
+      numNodes(0)
+{}
+
+TraceCPU::ElasticDataGen::GraphNode*
+TraceCPU::ElasticDataGen::DepGraph::allocate()
+{
+    if (freeNodes.empty()) {
+        nodes.emplace_back(new GraphNode);
+        return nodes.back().get();
     }
+    GraphNode* node = freeNodes.back();
+    freeNodes.pop_back();
+    return node;
+}
+
+void
+TraceCPU::ElasticDataGen::DepGraph::recycle(GraphNode* node)
+{
+    node->dependents.clear();
+    freeNodes.push_back(node);
+}
+
+void
+TraceCPU::ElasticDataGen::DepGraph::insert(GraphNode* node)
+{
+    assert(!find(node->seqNum));
+    // Make room if the slot is held by a node whose sequence number is a
+    // multiple of the ring size apart
+    while (ring[node->seqNum & mask])
+        grow();
+    ring[node->seqNum & mask] = node;
+    ++numNodes;
+}
+
+void
+TraceCPU::ElasticDataGen::DepGraph::erase(GraphNode* node)
+{
+    assert(ring[node->seqNum & mask] == node);
+    ring[node->seqNum & mask] = nullptr;
+    --numNodes;
+    recycle(node);
+}
+
+void
+TraceCPU::ElasticDataGen::DepGraph::grow()
+{
+    std::vector<GraphNode*> old_ring(2 * ring.size(), nullptr);
+    old_ring.swap(ring);
+    mask = ring.size() - 1;
+    // Nodes in distinct slots remain in distinct slots after doubling
+    for (auto node : old_ring) {
+        if (node)
+            ring[node->seqNum & mask] = node;
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::ReadyQueue::push(const ReadyNode& ready_node)
+{
+    heap.push_back(ready_node);
+    std::push_heap(heap.begin(), heap.end(), Later());
+}
+
+void
+TraceCPU::ElasticDataGen::ReadyQueue::pop()
+{
+    if (pinned) {
+        pinned = false;
+    } else {
+        assert(!heap.empty());
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        heap.pop_back();
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::ReadyQueue::pinFront()
+{
+    if (!pinned) {
+        head = heap.front();
+        pop();
+        pinned = true;
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::ReadyQueue::adjustExecTicks(Tick offset)
+{
+    // Shifting all ticks by the same amount keeps the heap ordered
+    if (pinned)
+        head.execTick -= offset;
+    for (auto& ready_node : heap)
+        ready_node.execTick -= offset;
+}
+
+std::vector<TraceCPU::ElasticDataGen::ReadyNode>
+TraceCPU::ElasticDataGen::ReadyQueue::sorted() const
+{
+    std::vector<ReadyNode> nodes(heap);
+    std::sort(nodes.begin(), nodes.end(),
+              [](const ReadyNode& a, const ReadyNode& b) {
+                  return Later()(b, a); });
+    if (pinned)
+        nodes.insert(nodes.begin(), head);
+    return nodes;
 }
 
 TraceCPU::ElasticDataGen::HardwareResource::HardwareResource(
@@ -834,8 +899,8 @@ TraceCPU::ElasticDataGen::HardwareResource::occupy(const GraphNode* new_node)
     // Occupy ROB entry for the issued node
     // Merely maintain the oldest node, i.e. numerically least robNum by saving
     // it in the variable oldestInFLightRobNum.
-    inFlightNodes[new_node->seqNum] = new_node->robNum;
-    oldestInFlightRobNum = inFlightNodes.begin()->second;
+    inFlightNodes.push(new_node->robNum);
+    oldestInFlightRobNum = inFlightNodes.top();
 
     // Occupy Load/Store Buffer entry for the issued node if applicable
     if (new_node->isLoad()) {
@@ -850,12 +915,18 @@ TraceCPU::ElasticDataGen::HardwareResource::occupy(const GraphNode* new_node)
 void
 TraceCPU::ElasticDataGen::HardwareResource::release(const GraphNode* done_node)
 {
-    assert(!inFlightNodes.empty());
+    assert(inFlightNodes.size() > releasedNodes.size());
     DPRINTFR(TraceCPUData, "\tClearing done seq. num %d from inFlightNodes..\n",
         done_node->seqNum);
 
-    assert(inFlightNodes.find(done_node->seqNum) != inFlightNodes.end());
-    inFlightNodes.erase(done_node->seqNum);
+    // Nodes may complete out of order, so only drop the released nodes
+    // once they have become the oldest in flight
+    releasedNodes.push(done_node->robNum);
+    while (!releasedNodes.empty() &&
+           releasedNodes.top() == inFlightNodes.top()) {
+        releasedNodes.pop();
+        inFlightNodes.pop();
+    }
 
     if (inFlightNodes.empty()) {
         // If we delete the only in-flight node and then the
@@ -864,12 +935,12 @@ TraceCPU::ElasticDataGen::HardwareResource::release(const GraphNode* done_node)
     } else {
         // Set the oldest in-flight node rob number equal to the first node in
         // the inFlightNodes since that will have the numerically least value.
-        oldestInFlightRobNum = inFlightNodes.begin()->second;
+        oldestInFlightRobNum = inFlightNodes.top();
     }
 
     DPRINTFR(TraceCPUData, "\tCleared. inFlightNodes.size() = %d, "
-        "oldestInFlightRobNum = %d\n", inFlightNodes.size(),
-        oldestInFlightRobNum);
+        "oldestInFlightRobNum = %d\n",
+        inFlightNodes.size() - releasedNodes.size(), oldestInFlightRobNum);
 
     // A store is considered complete when a request is sent, thus ROB entry is
     // freed. But it occupies an entry in the Store Buffer until its response
@@ -1179,8 +1250,10 @@ TraceCPU::DcachePort::recvReqRetry()
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
     const std::string& filename,
-    const double time_multiplier)
+    const double time_multiplier,
+    const std::string& cache_dir)
     : trace(filename),
+      nextRecord(0),
       timeMultiplier(time_multiplier),
       microOpCount(0)
 {
@@ -1198,82 +1271,117 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    if (!cache_dir.empty()) {
+        cache.reset(new TraceCache(cache_dir, filename, "elastic",
+                                   sizeof(DecodedRecord)));
+        if (!cache->map()) {
+            // Decode the whole trace once and replay from the cache
+            inform("Building trace cache %s\n", cache->path());
+            cache->beginWrite();
+            ProtoMessage::InstDepRecord pkt_msg;
+            DecodedRecord record;
+            while (trace.read(pkt_msg)) {
+                decode(pkt_msg, record);
+                cache->append(&record);
+            }
+            cache->endWrite();
+        }
+    }
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
     trace.reset();
+    nextRecord = 0;
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::decode(
+    const ProtoMessage::InstDepRecord& pkt_msg, DecodedRecord& record)
+{
+    // Clear the padding as well, the record may end up in the cache
+    memset(&record, 0, sizeof(record));
+
+    // Required fields
+    record.seqNum = pkt_msg.seq_num();
+    record.type = pkt_msg.type();
+    record.compDelay = pkt_msg.comp_delay();
+
+    // Repeated field robDepList
+    assert((pkt_msg.rob_dep()).size() <= GraphNode::maxRobDep);
+    for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
+        record.robDep[record.numRobDep] = pkt_msg.rob_dep(i);
+        record.numRobDep += 1;
+    }
+
+    // Repeated field
+    assert((pkt_msg.reg_dep()).size() <= TheISA::MaxInstSrcRegs);
+    for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
+        // There is a possibility that an instruction has both, a register
+        // and order dependency on an instruction. In such a case, the
+        // register dependency is omitted
+        bool duplicate = false;
+        for (int j = 0; j < record.numRobDep; j++) {
+            duplicate |= (pkt_msg.reg_dep(i) == record.robDep[j]);
+        }
+        if (!duplicate) {
+            record.regDep[record.numRegDep] = pkt_msg.reg_dep(i);
+            record.numRegDep += 1;
+        }
+    }
+
+    // Optional fields, which are zero if not present
+    record.physAddr = pkt_msg.has_p_addr() ? pkt_msg.p_addr() : 0;
+    record.virtAddr = pkt_msg.has_v_addr() ? pkt_msg.v_addr() : 0;
+    record.size = pkt_msg.has_size() ? pkt_msg.size() : 0;
+    record.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+    record.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
+    record.weight = pkt_msg.has_weight() ? pkt_msg.weight() : 0;
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::populate(const DecodedRecord& record,
+                                                GraphNode* element)
+{
+    element->seqNum = record.seqNum;
+    element->type = static_cast<RecordType>(record.type);
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = record.compDelay * timeMultiplier;
+
+    element->robDep = record.robDep;
+    element->numRobDep = record.numRobDep;
+    element->regDep = record.regDep;
+    element->numRegDep = record.numRegDep;
+
+    element->physAddr = record.physAddr;
+    element->virtAddr = record.virtAddr;
+    element->size = record.size;
+    element->flags = record.flags;
+    element->pc = record.pc;
+
+    // ROB occupancy number
+    ++microOpCount;
+    microOpCount += record.weight;
+    element->robNum = microOpCount;
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
+    if (cache) {
+        if (nextRecord == cache->size())
+            return false;
+        populate(cache->get<DecodedRecord>(nextRecord++), element);
+        return true;
+    }
+
     ProtoMessage::InstDepRecord pkt_msg;
     if (trace.read(pkt_msg)) {
-        // Required fields
-        element->seqNum = pkt_msg.seq_num();
-        element->type = pkt_msg.type();
-        // Scale the compute delay to effectively scale the Trace CPU frequency
-        element->compDelay = pkt_msg.comp_delay() * timeMultiplier;
-
-        // Repeated field robDepList
-        element->clearRobDep();
-        assert((pkt_msg.rob_dep()).size() <= element->maxRobDep);
-        for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
-            element->robDep[element->numRobDep] = pkt_msg.rob_dep(i);
-            element->numRobDep += 1;
-        }
-
-        // Repeated field
-        element->clearRegDep();
-        assert((pkt_msg.reg_dep()).size() <= TheISA::MaxInstSrcRegs);
-        for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
-            // There is a possibility that an instruction has both, a register
-            // and order dependency on an instruction. In such a case, the
-            // register dependency is omitted
-            bool duplicate = false;
-            for (int j = 0; j < element->numRobDep; j++) {
-                duplicate |= (pkt_msg.reg_dep(i) == element->robDep[j]);
-            }
-            if (!duplicate) {
-                element->regDep[element->numRegDep] = pkt_msg.reg_dep(i);
-                element->numRegDep += 1;
-            }
-        }
-
-        // Optional fields
-        if (pkt_msg.has_p_addr())
-            element->physAddr = pkt_msg.p_addr();
-        else
-            element->physAddr = 0;
-
-        if (pkt_msg.has_v_addr())
-            element->virtAddr = pkt_msg.v_addr();
-        else
-            element->virtAddr = 0;
-
-        if (pkt_msg.has_size())
-            element->size = pkt_msg.size();
-        else
-            element->size = 0;
-
-        if (pkt_msg.has_flags())
-            element->flags = pkt_msg.flags();
-        else
-            element->flags = 0;
-
-        if (pkt_msg.has_pc())
-            element->pc = pkt_msg.pc();
-        else
-            element->pc = 0;
-
-        // ROB occupancy number
-        ++microOpCount;
-        if (pkt_msg.has_weight()) {
-            microOpCount += pkt_msg.weight();
-        }
-        element->robNum = microOpCount;
+        DecodedRecord record;
+        decode(pkt_msg, record);
+        populate(record, element);
         return true;
     }
 
@@ -1387,8 +1495,9 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(
+    const std::string& filename, const std::string& cache_dir)
+    : trace(filename), nextRecord(0)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -1400,28 +1509,69 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
                   header_msg.tick_freq());
         }
     }
+
+    if (!cache_dir.empty()) {
+        cache.reset(new TraceCache(cache_dir, filename, "fixed",
+                                   sizeof(DecodedRecord)));
+        if (!cache->map()) {
+            // Decode the whole trace once and replay from the cache
+            inform("Building trace cache %s\n", cache->path());
+            cache->beginWrite();
+            ProtoMessage::Packet pkt_msg;
+            DecodedRecord record;
+            while (trace.read(pkt_msg)) {
+                decode(pkt_msg, record);
+                cache->append(&record);
+            }
+            cache->endWrite();
+        }
+    }
 }
 
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
     trace.reset();
+    nextRecord = 0;
+}
+
+void
+TraceCPU::FixedRetryGen::InputStream::decode(
+    const ProtoMessage::Packet& pkt_msg, DecodedRecord& record)
+{
+    // Clear the padding as well, the record may end up in the cache
+    memset(&record, 0, sizeof(record));
+    record.cmd = pkt_msg.cmd();
+    record.addr = pkt_msg.addr();
+    record.blocksize = pkt_msg.size();
+    record.tick = pkt_msg.tick();
+    record.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+    record.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
-    ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
-        element->cmd = pkt_msg.cmd();
-        element->addr = pkt_msg.addr();
-        element->blocksize = pkt_msg.size();
-        element->tick = pkt_msg.tick();
-        element->flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
-        element->pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
-        return true;
+    DecodedRecord msg_record;
+    const DecodedRecord* record = &msg_record;
+    if (cache) {
+        if (nextRecord == cache->size())
+            return false;
+        record = &cache->get<DecodedRecord>(nextRecord++);
+    } else {
+        ProtoMessage::Packet pkt_msg;
+        if (!trace.read(pkt_msg)) {
+            // We have reached the end of the file
+            return false;
+        }
+        decode(pkt_msg, msg_record);
     }
 
-    // We have reached the end of the file
-    return false;
+    element->cmd = record->cmd;
+    element->addr = record->addr;
+    element->blocksize = record->blocksize;
+    element->tick = record->tick;
+    element->flags = record->flags;
+    element->pc = record->pc;
+    return true;
 }
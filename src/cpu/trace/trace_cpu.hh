@@ -40,13 +40,16 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <queue>
 #include <set>
-#include <unordered_map>
+#include <vector>
 
 #include "arch/registers.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/trace_cache.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -70,7 +73,7 @@
  * timing from the trace and without performing real execution of micro-ops. As
  * soon as the last dependency for an instruction is complete, its
  * computational delay, also provided in the input trace is added. The
- * dependency-free nodes are maintained in a list, called 'ReadyList', ordered
+ * dependency-free nodes are maintained in a heap, called 'ReadyList', ordered
  * by ready time. Instructions which depend on load stall until the responses
  * for read requests are received thus achieving elastic replay. If the
  * dependency is not found when adding a new node, it is assumed complete.
@@ -91,7 +94,7 @@
  * sequence number is at times much higher due to squashing and trace replay is
  * focused on correct path modeling.
  *
- * A map called 'inFlightNodes' is added to track nodes that are not only in
+ * A heap called 'inFlightNodes' is added to track nodes that are not only in
  * the readyList but also load nodes that are executed (and thus removed from
  * readyList) but are not complete. ReadyList handles what and when to execute
  * next node while the inFlightNodes is used for resource modelling. The oldest
@@ -391,17 +394,45 @@ class TraceCPU : public BaseCPU
 
           private:
 
+            /**
+             * A decoded trace record, as stored in the trace cache. The
+             * fields are laid out without padding.
+             */
+            struct DecodedRecord
+            {
+                uint64_t addr;
+                uint64_t blocksize;
+                uint64_t tick;
+                uint64_t flags;
+                uint64_t pc;
+                uint32_t cmd;
+                uint32_t pad;
+            };
+
+            /** Decode a protobuf message into a record */
+            static void decode(const ProtoMessage::Packet& pkt_msg,
+                               DecodedRecord& record);
+
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            /** Cache of decoded records, if enabled */
+            std::unique_ptr<TraceCache> cache;
+
+            /** Index of the next record to read from the cache */
+            size_t nextRecord;
+
           public:
 
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param cache_dir Directory of the decoded trace cache, or
+             *                  empty to read the protobuf trace directly
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename,
+                        const std::string& cache_dir);
 
             /**
              * Reset the stream such that it can be played once
@@ -424,11 +455,12 @@ class TraceCPU : public BaseCPU
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file)
+                   const std::string& trace_file,
+                   const std::string& cache_dir)
             : owner(_owner),
               port(_port),
               requestorId(requestor_id),
-              trace(trace_file),
+              trace(trace_file, cache_dir),
               genName(owner.name() + ".fixedretry." + _name),
               retryPkt(nullptr),
               delta(0),
@@ -689,6 +721,130 @@ class TraceCPU : public BaseCPU
             Tick execTick;
         };
 
+        /**
+         * The DepGraph holds the nodes of the dependency window, i.e. the
+         * nodes read from the trace that have not completed yet. The nodes
+         * are stored in a ring indexed by sequence number, so finding the
+         * parent of a new node is a single access. The ring doubles in size
+         * whenever two nodes in the window map to the same slot. Completed
+         * nodes are recycled for the records read next, which also keeps
+         * their vector of dependents allocated.
+         */
+        class DepGraph
+        {
+          public:
+            /**
+             * @param window_size window size of the trace, used to size
+             *                    the ring initially
+             */
+            DepGraph(uint32_t window_size);
+
+            /** Get an unused node to read a record into */
+            GraphNode* allocate();
+
+            /** Return a node that was allocated but never inserted */
+            void recycle(GraphNode* node);
+
+            /** Add a node to the graph under its sequence number */
+            void insert(GraphNode* node);
+
+            /** Remove a completed node from the graph and recycle it */
+            void erase(GraphNode* node);
+
+            /**
+             * Find a node in the graph.
+             *
+             * @param seq_num sequence number of the node
+             * @return the node, or nullptr if it is not in the graph
+             */
+            GraphNode*
+            find(NodeSeqNum seq_num) const
+            {
+                GraphNode* node = ring[seq_num & mask];
+                return (node && node->seqNum == seq_num) ? node : nullptr;
+            }
+
+            size_t size() const { return numNodes; }
+
+            bool empty() const { return numNodes == 0; }
+
+          private:
+            /** Double the size of the ring */
+            void grow();
+
+            /** Nodes in the graph, indexed by sequence number */
+            std::vector<GraphNode*> ring;
+
+            /** Mask to turn a sequence number into a ring index */
+            NodeSeqNum mask;
+
+            /** Number of nodes in the graph */
+            size_t numNodes;
+
+            /** Storage for all nodes ever allocated */
+            std::vector<std::unique_ptr<GraphNode>> nodes;
+
+            /** Nodes that are available for reuse */
+            std::vector<GraphNode*> freeNodes;
+        };
+
+        /**
+         * The ReadyQueue holds the nodes that are ready to execute, ordered
+         * by ascending execute tick and then by sequence number. It is kept
+         * as a binary heap, apart from a head node whose request is waiting
+         * for a retry from the cache. Such a node stays at the head until it
+         * is popped, even if nodes with an earlier execute tick are pushed.
+         */
+        class ReadyQueue
+        {
+          public:
+            ReadyQueue() : pinned(false) {}
+
+            bool empty() const { return !pinned && heap.empty(); }
+
+            size_t size() const { return heap.size() + (pinned ? 1 : 0); }
+
+            /** The node to execute next */
+            const ReadyNode&
+            front() const
+            {
+                return pinned ? head : heap.front();
+            }
+
+            /** Add a node in order of its execute tick */
+            void push(const ReadyNode& ready_node);
+
+            /** Remove the node at the head */
+            void pop();
+
+            /** Keep the node at the head there until it is popped */
+            void pinFront();
+
+            /** Subtract an offset from the execute tick of all nodes */
+            void adjustExecTicks(Tick offset);
+
+            /** Get the nodes in execution order, for debugging */
+            std::vector<ReadyNode> sorted() const;
+
+          private:
+            /** Heap ordering, putting the earliest node on top */
+            struct Later
+            {
+                bool
+                operator()(const ReadyNode& a, const ReadyNode& b) const
+                {
+                    return a.execTick > b.execTick ||
+                        (a.execTick == b.execTick && a.seqNum > b.seqNum);
+                }
+            };
+
+            std::vector<ReadyNode> heap;
+
+            /** The head node kept in place while it awaits a retry */
+            ReadyNode head;
+            bool pinned;
+        };
+
         /**
          * The HardwareResource class models structures that hold the in-flight
          * nodes. When a node becomes dependency free, first check if resources
@@ -763,17 +919,26 @@ class TraceCPU : public BaseCPU
              */
             const uint16_t sizeLoadBuffer;
 
+            /** Min-heap of ROB numbers */
+            typedef std::priority_queue<NodeRobNum, std::vector<NodeRobNum>,
+                                        std::greater<NodeRobNum>> RobNumHeap;
+
+            /**
+             * A heap of the ROB numbers of the in-flight nodes. This includes
+             * all nodes that are in the readyList plus the loads for which a
+             * request has been sent which are not present in the readyList.
+             * But such loads are not yet complete and thus occupy resources.
+             * We need to query the oldest in-flight node, and as ROB numbers
+             * grow in program order that is the one on top of the heap.
+             */
+            RobNumHeap inFlightNodes;
+
             /**
-             * A map from the sequence number to the ROB number of the in-
-             * flight nodes. This includes all nodes that are in the readyList
-             * plus the loads for which a request has been sent which are not
-             * present in the readyList. But such loads are not yet complete
-             * and thus occupy resources. We need to query the oldest in-flight
-             * node and since a map container keeps all its keys sorted using
-             * the less than criterion, the first element is the in-flight node
-             * with the least sequence number, i.e. the oldest in-flight node.
+             * ROB numbers of the nodes released while an older node is still
+             * in flight. They are removed from both heaps once they reach
+             * the top of inFlightNodes.
              */
-            std::map<NodeSeqNum, NodeRobNum> inFlightNodes;
+            RobNumHeap releasedNodes;
 
             /** The ROB number of the oldest in-flight node */
             NodeRobNum oldestInFlightRobNum;
@@ -795,9 +960,46 @@ class TraceCPU : public BaseCPU
 
           private:
 
+            /**
+             * A decoded trace record, as stored in the trace cache. The
+             * compute delay is kept unscaled so the cache does not depend
+             * on the frequency multiplier. The fields are laid out without
+             * padding.
+             */
+            struct DecodedRecord
+            {
+                NodeSeqNum seqNum;
+                uint64_t compDelay;
+                uint64_t physAddr;
+                uint64_t virtAddr;
+                uint64_t pc;
+                uint64_t weight;
+                uint64_t flags;
+                GraphNode::RobDepArray robDep;
+                GraphNode::RegDepArray regDep;
+                uint32_t size;
+                uint8_t type;
+                uint8_t numRobDep;
+                uint8_t numRegDep;
+                uint8_t pad;
+            };
+
+            /** Decode a protobuf message into a record */
+            static void decode(const ProtoMessage::InstDepRecord& pkt_msg,
+                               DecodedRecord& record);
+
+            /** Populate a node from a decoded record */
+            void populate(const DecodedRecord& record, GraphNode* element);
+
             /** Input file stream for the protobuf trace */
             ProtoInputStream trace;
 
+            /** Cache of decoded records, if enabled */
+            std::unique_ptr<TraceCache> cache;
+
+            /** Index of the next record to read from the cache */
+            size_t nextRecord;
+
             /**
              * A multiplier for the compute delays in the trace to modulate
              * the Trace CPU frequency either up or down. The Trace CPU's
@@ -821,9 +1023,12 @@ class TraceCPU : public BaseCPU
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param cache_dir Directory of the decoded trace cache, or
+             *                  empty to read the protobuf trace directly
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        const std::string& cache_dir);
 
             /**
              * Reset the stream such that it can be played once
@@ -857,7 +1062,8 @@ class TraceCPU : public BaseCPU
             : owner(_owner),
               port(_port),
               requestorId(requestor_id),
-              trace(trace_file, 1.0 / params->freqMultiplier),
+              trace(trace_file, 1.0 / params->freqMultiplier,
+                    params->traceCacheDir),
               genName(owner.name() + ".elastic." + _name),
               retryPkt(nullptr),
               traceComplete(false),
@@ -865,7 +1071,9 @@ class TraceCPU : public BaseCPU
               execComplete(false),
               windowSize(trace.getWindowSize()),
               hwResource(params->sizeROB, params->sizeStoreBuffer,
-                         params->sizeLoadBuffer), elasticStats(&_owner, _name)
+                         params->sizeLoadBuffer),
+              depGraph(trace.getWindowSize()),
+              elasticStats(&_owner, _name)
         {
             DPRINTF(TraceCPUData, "Window size in the trace is %d.\n",
                     windowSize);
@@ -1029,7 +1237,7 @@ class TraceCPU : public BaseCPU
         HardwareResource hwResource;
 
         /** Store the depGraph of GraphNodes */
-        std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
+        DepGraph depGraph;
 
         /**
          * Queue of dependency-free nodes that are pending issue because
@@ -1040,8 +1248,8 @@ class TraceCPU : public BaseCPU
          */
         std::queue<const GraphNode*> depFreeQueue;
 
-        /** List of nodes that are ready to execute */
-        std::list<ReadyNode> readyList;
+        /** Queue of nodes that are ready to execute */
+        ReadyQueue readyList;
 
       protected:
         // Defining the a stat group
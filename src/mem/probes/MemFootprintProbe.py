@@ -45,3 +45,8 @@ class MemFootprintProbe(BaseMemProbe):
     system = Param.System(Parent.any,
                           "System pointer to get cache line and mem size")
     page_size = Param.Unsigned(4096, "Page size for page-level footprint")
+
+    # Histograms of the footprint of fixed-length intervals
+    interval = Param.Latency('0ns', "Length of the intervals of the "
+                             "footprint histograms (0 to disable)")
+    hist_bins = Param.Unsigned(20, "Bins in the footprint histograms")
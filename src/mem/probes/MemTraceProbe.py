@@ -47,6 +47,13 @@ class MemTraceProbe(BaseMemProbe):
     # For requests with a valid PC, include the PC in the trace
     with_pc = Param.Bool(False, "Include PC info in the trace")
 
+    # Write fixed-size binary records in blocks, compressed and written
+    # by a helper thread, rather than one protobuf message per packet
+    binary = Param.Bool(False, "Write a batched binary trace")
+
+    # Number of records per block of a binary trace
+    block_records = Param.Unsigned(4096, "Records per binary trace block")
+
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
@@ -52,6 +52,14 @@ class StackDistProbe(BaseMemProbe):
     # enable verification stack
     verify = Param.Bool(False, "Verify behaviuor with reference implementation")
 
+    # spatially hashed sampling of the addresses (SHARDS), the
+    # histograms only count the accesses to sampled addresses and their
+    # stack distances are scaled up by the sampling rate
+    sample_rate = Param.Float(1.0, "Fraction of the addresses to sample")
+    max_samples = Param.UInt64(0, "Maximum number of sampled addresses "
+                               "to track, lowering the sampling rate as "
+                               "needed (0 for no limit)")
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned('16', "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -47,10 +47,15 @@ MemFootprintProbe::MemFootprintProbe(MemFootprintProbeParams *p)
       pageSizeLg2(floorLog2(p->page_size)),
       totalCacheLinesInMem(p->system->memSize() / p->system->cacheLineSize()),
       totalPagesInMem(p->system->memSize() / p->page_size),
+      interval(p->interval),
+      histBins(p->hist_bins),
+      intervalEnd(p->interval),
       cacheLines(),
       cacheLinesAll(),
       pages(),
       pagesAll(),
+      cacheLinesInterval(),
+      pagesInterval(),
       system(p->system)
 {
     fatal_if(!isPowerOf2(system->cacheLineSize()),
@@ -80,30 +85,63 @@ MemFootprintProbe::regStats()
         .desc("Total memory footprint at page granularity since simulation "
               "begin")
         .flags(nozero | nonan);
+    fpCacheLineInterval.name(name() + ".cacheline_interval")
+        .desc("Memory footprint of each interval at cache line granularity")
+        .init(histBins)
+        .flags(interval ? pdf : nozero);
+    fpPageInterval.name(name() + ".page_interval")
+        .desc("Memory footprint of each interval at page granularity")
+        .init(histBins)
+        .flags(interval ? pdf : nozero);
     // clang-format on
 
     registerResetCallback([this]() { statReset(); });
 }
 
 void
-MemFootprintProbe::insertAddr(Addr addr, AddrSet *set, uint64_t limit)
+MemFootprintProbe::insertAddr(Addr num, AddrSet *set, uint64_t limit)
 {
-    set->insert(addr);
+    set->insert(num);
     assert(set->size() <= limit);
 }
 
+void
+MemFootprintProbe::endIntervals()
+{
+    fpCacheLineInterval.sample(
+        cacheLinesInterval.size() << cacheLineSizeLg2);
+    fpPageInterval.sample(pagesInterval.size() << pageSizeLg2);
+    cacheLinesInterval.clear();
+    pagesInterval.clear();
+
+    // Intervals without any access have an empty footprint
+    const Tick idle = (curTick() - intervalEnd) / interval;
+    if (idle) {
+        fpCacheLineInterval.sample(0, idle);
+        fpPageInterval.sample(0, idle);
+    }
+    intervalEnd += (idle + 1) * interval;
+}
+
 void
 MemFootprintProbe::handleRequest(const ProbePoints::PacketInfo &pi)
 {
     if (!pi.cmd.isRequest() || !system->isMemAddr(pi.addr))
         return;
 
-    const Addr cl_addr = (pi.addr >> cacheLineSizeLg2) << cacheLineSizeLg2;
-    const Addr page_addr = (pi.addr >> pageSizeLg2) << pageSizeLg2;
-    insertAddr(cl_addr, &cacheLines, totalCacheLinesInMem);
-    insertAddr(cl_addr, &cacheLinesAll, totalCacheLinesInMem);
-    insertAddr(page_addr, &pages, totalPagesInMem);
-    insertAddr(page_addr, &pagesAll, totalPagesInMem);
+    const Addr cl_num = pi.addr >> cacheLineSizeLg2;
+    const Addr page_num = pi.addr >> pageSizeLg2;
+    insertAddr(cl_num, &cacheLines, totalCacheLinesInMem);
+    insertAddr(cl_num, &cacheLinesAll, totalCacheLinesInMem);
+    insertAddr(page_num, &pages, totalPagesInMem);
+    insertAddr(page_num, &pagesAll, totalPagesInMem);
+
+    if (interval) {
+        if (curTick() >= intervalEnd)
+            endIntervals();
+        cacheLinesInterval.insert(cl_num);
+        pagesInterval.insert(page_num);
+    }
 
     assert(cacheLines.size() <= cacheLinesAll.size());
     assert(pages.size() <= pagesAll.size());
@@ -119,6 +157,9 @@ MemFootprintProbe::statReset()
 {
     cacheLines.clear();
     pages.clear();
+    cacheLinesInterval.clear();
+    pagesInterval.clear();
+    intervalEnd = curTick() + interval;
 }
 
 MemFootprintProbe *
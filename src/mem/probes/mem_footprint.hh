@@ -39,9 +39,8 @@
 #ifndef __MEM_PROBES_MEM_FOOTPRINT_HH__
 #define __MEM_PROBES_MEM_FOOTPRINT_HH__
 
-#include <unordered_set>
-
 #include "base/callback.hh"
+#include "base/sparse_bitmap.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "sim/stats.hh"
@@ -51,10 +50,12 @@ struct MemFootprintProbeParams;
 
 /// Probe to track footprint of accessed memory
 /// Two granularity of footprint measurement i.e. cache line and page
+/// The accessed cache lines and pages are tracked by number in sparse
+/// bitmaps, optionally also over fixed-length intervals
 class MemFootprintProbe : public BaseMemProbe
 {
   public:
-    typedef std::unordered_set<Addr> AddrSet;
+    typedef SparseBitmap AddrSet;
 
     MemFootprintProbe(MemFootprintProbeParams *p);
     void regStats() override;
@@ -68,9 +69,18 @@ class MemFootprintProbe : public BaseMemProbe
     const uint8_t pageSizeLg2;
     const uint64_t totalCacheLinesInMem;
     const uint64_t totalPagesInMem;
+    /// Length of the footprint histogram intervals, 0 if disabled
+    const Tick interval;
+    /// Bins in the footprint histograms
+    const unsigned histBins;
+    /// End of the current interval
+    Tick intervalEnd;
 
-    void insertAddr(Addr addr, AddrSet *set, uint64_t limit);
+    void insertAddr(Addr num, AddrSet *set, uint64_t limit);
     void handleRequest(const ProbePoints::PacketInfo &pkt_info) override;
+    /// Sample the footprint of the intervals that ended, and start
+    /// tracking the current one
+    void endIntervals();
 
     /// Footprint at cache line size granularity
     Stats::Scalar fpCacheLine;
@@ -80,6 +90,11 @@ class MemFootprintProbe : public BaseMemProbe
     Stats::Scalar fpPage;
     /// Footprint at page granularity, since simulation begin
     Stats::Scalar fpPageTotal;
+    /// Distribution of the footprint of each interval at cache line size
+    /// granularity
+    Stats::Histogram fpCacheLineInterval;
+    /// Distribution of the footprint of each interval at page granularity
+    Stats::Histogram fpPageInterval;
 
     // Addr set to track unique cache lines accessed
     AddrSet cacheLines;
@@ -89,6 +104,10 @@ class MemFootprintProbe : public BaseMemProbe
     AddrSet pages;
     // Addr set to track unique pages accessed since simulation begin
     AddrSet pagesAll;
+    // Addr set to track unique cache lines accessed in this interval
+    AddrSet cacheLinesInterval;
+    // Addr set to track unique pages accessed in this interval
+    AddrSet pagesInterval;
     System *system;
 };
 
@@ -46,6 +46,7 @@
 MemTraceProbe::MemTraceProbe(MemTraceProbeParams *p)
     : BaseMemProbe(p),
       traceStream(nullptr),
+      binTraceWriter(nullptr),
       system(p->system),
       withPC(p->with_pc)
 {
@@ -57,11 +58,14 @@ MemTraceProbe::MemTraceProbe(MemTraceProbeParams *p)
 
         const std::string suffix = ".gz";
         // If trace_compress has been set, check the suffix. Append
-        // accordingly.
-        if (p->trace_compress &&
+        // accordingly. Binary traces compress their blocks and are
+        // not gzip files.
+        if (p->trace_compress && !p->binary &&
             filename.compare(filename.size() - suffix.size(), suffix.size(),
                              suffix) != 0)
             filename = filename + suffix;
+    } else if (p->binary) {
+        filename = simout.resolve(name() + ".bintrc");
     } else {
         // Generate a filename from the name of the SimObject. Append .trc
         // and .gz if we want compression enabled.
@@ -69,7 +73,13 @@ MemTraceProbe::MemTraceProbe(MemTraceProbeParams *p)
                                   (p->trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    if (p->binary) {
+        binTraceWriter = new BinPacketTraceWriter(filename,
+                                                  p->trace_compress,
+                                                  p->block_records);
+    } else {
+        traceStream = new ProtoOutputStream(filename);
+    }
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -92,7 +102,10 @@ MemTraceProbe::startup()
         id_string->set_value(system->getRequestorName(i));
     }
 
-    traceStream->write(header_msg);
+    if (binTraceWriter)
+        binTraceWriter->writeHeader(header_msg);
+    else
+        traceStream->write(header_msg);
 }
 
 void
@@ -100,11 +113,26 @@ MemTraceProbe::closeStreams()
 {
     if (traceStream != NULL)
         delete traceStream;
+    if (binTraceWriter != NULL)
+        delete binTraceWriter;
 }
 
 void
 MemTraceProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
 {
+    if (binTraceWriter) {
+        BinPacketRecord record;
+        record.tick = curTick();
+        record.cmd = pkt_info.cmd.toInt();
+        record.flags = pkt_info.flags;
+        record.addr = pkt_info.addr;
+        record.size = pkt_info.size;
+        record.pc = withPC ? pkt_info.pc : 0;
+        record.pktId = pkt_info.id;
+        binTraceWriter->append(record);
+        return;
+    }
+
     ProtoMessage::Packet pkt_msg;
 
     pkt_msg.set_tick(curTick());
@@ -40,6 +40,7 @@
 
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
+#include "proto/bin_packet_trace.hh"
 #include "proto/protoio.hh"
 
 struct MemTraceProbeParams;
@@ -66,6 +67,9 @@ class MemTraceProbe : public BaseMemProbe
     /** Trace output stream */
     ProtoOutputStream *traceStream;
 
+    /** Binary trace writer, used instead of the stream if enabled */
+    BinPacketTraceWriter *binTraceWriter;
+
     System *system;
 
   private:
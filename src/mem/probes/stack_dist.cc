@@ -45,7 +45,7 @@ StackDistProbe::StackDistProbe(StackDistProbeParams *p)
       lineSize(p->line_size),
       disableLinearHists(p->disable_linear_hists),
       disableLogHists(p->disable_log_hists),
-      calc(p->verify)
+      calc(p->verify, p->sample_rate, p->max_samples)
 {
     fatal_if(p->system->cacheLineSize() > p->line_size,
              "The stack distance probe must use a cache line size that is "
@@ -104,6 +104,11 @@ StackDistProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    // When sampling, only the accesses to sampled addresses are
+    // recorded; their stack distances are scaled by the calculator
+    if (!calc.isSampled(aligned_addr))
+        return;
+
     // Calculate the stack distance
     const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
@@ -163,6 +163,23 @@ NetDest::smallestElement(MachineType machine) const
     panic("No smallest element of given MachineType.");
 }
 
+bool
+NetDest::singleElement(NodeID &node) const
+{
+    bool found = false;
+    for (int i = 0; i < m_bits.size(); i++) {
+        const int n = m_bits[i].count();
+        if (n == 0)
+            continue;
+        if (n > 1 || found)
+            return false;
+        found = true;
+        node = MachineType_base_number(MachineType_from_base_level(i)) +
+            m_bits[i].smallestElement();
+    }
+    return found;
+}
+
 // Returns true iff all bits are set
 bool
 NetDest::isBroadcast() const
@@ -84,6 +84,10 @@ class NetDest
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
+    // Returns true if the set holds exactly one element, and sets node
+    // to its global node id
+    bool singleElement(NodeID &node) const;
+
     void resize();
     int getSize() const { return m_bits.size(); }
 
@@ -31,6 +31,7 @@
 
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 
 // Credit Signal for buffers inside VC
 // Carries m_vc (inherits from flit.hh)
@@ -43,30 +44,40 @@ Credit::Credit(int vc, bool is_free_signal, Tick curTime)
     m_type = CREDIT_;
 }
 
+void
+Credit::reset(int vc, bool is_free_signal, Tick curTime)
+{
+    // Credits carry no route, so the existing one is kept
+    flit::reset(0, vc, 0, m_route, 0, nullptr, 0, 0, curTime);
+    m_is_free_signal = is_free_signal;
+    m_type = CREDIT_;
+}
+
 flit *
-Credit::serialize(int ser_id, int parts, uint32_t bWidth)
+Credit::serialize(int ser_id, int parts, uint32_t bWidth, FlitPool *pool)
 {
     DPRINTF(RubyNetwork, "Serializing a credit\n");
     bool new_free = false;
     if ((ser_id+1 == parts) && m_is_free_signal) {
         new_free = true;
     }
-    Credit *new_credit_flit = new Credit(m_vc, new_free, m_time);
+    Credit *new_credit_flit = pool->allocCredit(m_vc, new_free, m_time);
     return new_credit_flit;
 }
 
 flit *
-Credit::deserialize(int des_id, int num_flits, uint32_t bWidth)
+Credit::deserialize(int des_id, int num_flits, uint32_t bWidth,
+                    FlitPool *pool)
 {
     DPRINTF(RubyNetwork, "DeSerializing a credit vc:%d free:%d\n",
     m_vc, m_is_free_signal);
     if (m_is_free_signal) {
         // We are not going to get anymore credits for this vc
         // So send a credit in any case
-        return new Credit(m_vc, true, m_time);
+        return pool->allocCredit(m_vc, true, m_time);
     }
 
-    return new Credit(m_vc, false, m_time);
+    return pool->allocCredit(m_vc, false, m_time);
 }
 
 void
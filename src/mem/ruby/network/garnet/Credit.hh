@@ -48,9 +48,14 @@ class Credit : public flit
     Credit() {};
     Credit(int vc, bool is_free_signal, Tick curTime);
 
+    // Re-initialize a credit recycled by the FlitPool
+    void reset(int vc, bool is_free_signal, Tick curTime);
+
     // Functions used by SerDes
-    flit* serialize(int ser_id, int parts, uint32_t bWidth);
-    flit* deserialize(int des_id, int num_flits, uint32_t bWidth);
+    flit* serialize(int ser_id, int parts, uint32_t bWidth,
+                    FlitPool *pool);
+    flit* deserialize(int des_id, int num_flits, uint32_t bWidth,
+                      FlitPool *pool);
     void print(std::ostream& out) const;
 
     ~Credit() {};
@@ -54,6 +54,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_num_buffered++;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -66,6 +67,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Number of SA winners waiting in switchBuffers
+    int m_num_buffered;
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET_0_CROSSBARSWITCH_HH__
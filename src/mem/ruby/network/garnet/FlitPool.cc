@@ -0,0 +1,78 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/garnet/FlitPool.hh"
+
+#include "mem/ruby/network/garnet/Credit.hh"
+#include "mem/ruby/network/garnet/flit.hh"
+
+FlitPool::~FlitPool()
+{
+    for (auto t_flit : m_free_flits)
+        delete t_flit;
+    for (auto t_credit : m_free_credits)
+        delete t_credit;
+}
+
+flit *
+FlitPool::allocFlit(int id, int vc, int vnet, const RouteInfo &route,
+                    int size, const MsgPtr &msg_ptr, int MsgSize,
+                    uint32_t bWidth, Tick curTime)
+{
+    if (m_free_flits.empty()) {
+        return new flit(id, vc, vnet, route, size, msg_ptr, MsgSize,
+                        bWidth, curTime);
+    }
+
+    flit *t_flit = m_free_flits.back();
+    m_free_flits.pop_back();
+    t_flit->reset(id, vc, vnet, route, size, msg_ptr, MsgSize, bWidth,
+                  curTime);
+    return t_flit;
+}
+
+Credit *
+FlitPool::allocCredit(int vc, bool is_free_signal, Tick curTime)
+{
+    if (m_free_credits.empty())
+        return new Credit(vc, is_free_signal, curTime);
+
+    Credit *t_credit = m_free_credits.back();
+    m_free_credits.pop_back();
+    t_credit->reset(vc, is_free_signal, curTime);
+    return t_credit;
+}
+
+void
+FlitPool::release(flit *t_flit)
+{
+    if (t_flit->get_type() == CREDIT_) {
+        m_free_credits.push_back(static_cast<Credit *>(t_flit));
+    } else {
+        // Do not keep the message alive while the flit is unused
+        t_flit->get_msg_ptr().reset();
+        m_free_flits.push_back(t_flit);
+    }
+}
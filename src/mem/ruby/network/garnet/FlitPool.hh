@@ -0,0 +1,69 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+class flit;
+class Credit;
+
+/**
+ * Free lists of flits and credits owned by a GarnetNetwork.
+ *
+ * Every message is split into freshly allocated flits at the source NI
+ * and every hop creates a credit, so under load the network spends a lot
+ * of its time in the heap allocator. Objects released to the pool are
+ * re-initialized in place when they are handed out again, which also lets
+ * a recycled flit reuse the storage of its route's NetDest.
+ */
+class FlitPool
+{
+  public:
+    FlitPool() = default;
+    ~FlitPool();
+
+    flit *allocFlit(int id, int vc, int vnet, const RouteInfo &route,
+                    int size, const MsgPtr &msg_ptr, int MsgSize,
+                    uint32_t bWidth, Tick curTime);
+    Credit *allocCredit(int vc, bool is_free_signal, Tick curTime);
+
+    /** Return a flit or credit that has left the network. */
+    void release(flit *t_flit);
+
+  private:
+    FlitPool(const FlitPool &obj) = delete;
+    FlitPool &operator=(const FlitPool &obj) = delete;
+
+    std::vector<flit *> m_free_flits;
+    std::vector<Credit *> m_free_credits;
+};
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
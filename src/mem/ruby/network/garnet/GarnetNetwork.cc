@@ -188,6 +188,8 @@ GarnetNetwork::makeExtInLink(NodeID global_src, SwitchID dest, BasicLink* link,
     if (garnet_link->extBridgeEn) {
         DPRINTF(RubyNetwork, "Enable external bridge for %s\n",
             garnet_link->name());
+        garnet_link->extNetBridge[LinkDirection_In]->init_net_ptr(this);
+        garnet_link->extCredBridge[LinkDirection_In]->init_net_ptr(this);
         m_nis[local_src]->
         addOutPort(garnet_link->extNetBridge[LinkDirection_In],
                    garnet_link->extCredBridge[LinkDirection_In],
@@ -200,6 +202,8 @@ GarnetNetwork::makeExtInLink(NodeID global_src, SwitchID dest, BasicLink* link,
     if (garnet_link->intBridgeEn) {
         DPRINTF(RubyNetwork, "Enable internal bridge for %s\n",
             garnet_link->name());
+        garnet_link->intNetBridge[LinkDirection_In]->init_net_ptr(this);
+        garnet_link->intCredBridge[LinkDirection_In]->init_net_ptr(this);
         m_routers[dest]->
             addInPort(dst_inport_dirn,
                       garnet_link->intNetBridge[LinkDirection_In],
@@ -257,6 +261,8 @@ GarnetNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
     if (garnet_link->extBridgeEn) {
         DPRINTF(RubyNetwork, "Enable external bridge for %s\n",
             garnet_link->name());
+        garnet_link->extNetBridge[LinkDirection_Out]->init_net_ptr(this);
+        garnet_link->extCredBridge[LinkDirection_Out]->init_net_ptr(this);
         m_nis[local_dest]->
             addInPort(garnet_link->extNetBridge[LinkDirection_Out],
                       garnet_link->extCredBridge[LinkDirection_Out]);
@@ -267,6 +273,8 @@ GarnetNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
     if (garnet_link->intBridgeEn) {
         DPRINTF(RubyNetwork, "Enable internal bridge for %s\n",
             garnet_link->name());
+        garnet_link->intNetBridge[LinkDirection_Out]->init_net_ptr(this);
+        garnet_link->intCredBridge[LinkDirection_Out]->init_net_ptr(this);
         m_routers[src]->
             addOutPort(src_outport_dirn,
                        garnet_link->intNetBridge[LinkDirection_Out],
@@ -323,6 +331,8 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
     if (garnet_link->dstBridgeEn) {
         DPRINTF(RubyNetwork, "Enable destination bridge for %s\n",
             garnet_link->name());
+        garnet_link->dstNetBridge->init_net_ptr(this);
+        garnet_link->dstCredBridge->init_net_ptr(this);
         m_routers[dest]->addInPort(dst_inport_dirn,
             garnet_link->dstNetBridge, garnet_link->dstCredBridge);
     } else {
@@ -332,6 +342,8 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
     if (garnet_link->srcBridgeEn) {
         DPRINTF(RubyNetwork, "Enable source bridge for %s\n",
             garnet_link->name());
+        garnet_link->srcNetBridge->init_net_ptr(this);
+        garnet_link->srcCredBridge->init_net_ptr(this);
         m_routers[src]->
             addOutPort(src_outport_dirn, garnet_link->srcNetBridge,
                        routing_table_entry,
@@ -39,10 +39,11 @@
 #include <cmath>
 
 #include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "params/GarnetIntLink.hh"
 
 NetworkBridge::NetworkBridge(const Params *p)
-    :CreditLink(p)
+    :CreditLink(p), m_net_ptr(nullptr)
 {
     enCdc = true;
     enSerDes = true;
@@ -180,7 +181,7 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
             flit *fl = NULL;
             if (flitPossible) {
                 fl = t_flit->deserialize(lenBuffer[vc], num_flits,
-                    target_width);
+                    target_width, m_net_ptr->getFlitPool());
             }
 
             // Inform the credit serializer about the number
@@ -195,8 +196,8 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
                 lenBuffer[vc] = 0;
                 scheduleFlit(fl, serDesLatency);
             }
-            // Delete this flit, new flit is sent in any case
-            delete t_flit;
+            // Release this flit, new flit is sent in any case
+            m_net_ptr->getFlitPool()->release(t_flit);
         } else {
             // Serialize
             DPRINTF(RubyNetwork, "Serializing flit :%d -----> %d "
@@ -232,7 +233,8 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
             // num_flits could be zero for credits
             for (int i = 0; i < flitPossible; i++) {
                 // Ignore neutralized credits
-                flit *fl = t_flit->serialize(i, flitPossible, target_width);
+                flit *fl = t_flit->serialize(i, flitPossible, target_width,
+                                             m_net_ptr->getFlitPool());
                 scheduleFlit(fl, serDesLatency);
                 DPRINTF(RubyNetwork, "Serialized to flit[%d of %d parts]:"
                 " %s\n", i+1, flitPossible, *fl);
@@ -241,8 +243,8 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
             if (t_flit->get_type() != CREDIT_) {
                 coBridge->neutralize(vc, flitPossible);
             }
-            // Delete this flit, new flit is sent in any case
-            delete t_flit;
+            // Release this flit, new flit is sent in any case
+            m_net_ptr->getFlitPool()->release(t_flit);
         }
         return;
     }
@@ -58,6 +58,7 @@ class NetworkBridge: public CreditLink
     ~NetworkBridge();
 
     void initBridge(NetworkBridge *coBrid, bool cdc_en, bool serdes_en);
+    void init_net_ptr(GarnetNetwork *net_ptr) { m_net_ptr = net_ptr; }
 
     void wakeup();
     void neutralize(int vc, int eCredit);
@@ -67,6 +68,8 @@ class NetworkBridge: public CreditLink
     void setVcsPerVnet(uint32_t consumerVcs);
 
   protected:
+    GarnetNetwork *m_net_ptr;
+
     // Pointer to co-existing bridge
     // CreditBridge for Network Bridge and vice versa
     NetworkBridge *coBridge;
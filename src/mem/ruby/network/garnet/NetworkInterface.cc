@@ -241,12 +241,12 @@ NetworkInterface::wakeup()
 
                     // Simply send a credit back since we are not buffering
                     // this flit in the NI
-                    Credit *cFlit = new Credit(t_flit->get_vc(),
-                                               true, curTick());
+                    Credit *cFlit = m_net_ptr->getFlitPool()->
+                        allocCredit(t_flit->get_vc(), true, curTick());
                     iPort->sendCredit(cFlit);
-                    // Update stats and delete flit pointer
+                    // Update stats and release flit pointer
                     incrementStats(t_flit);
-                    delete t_flit;
+                    m_net_ptr->getFlitPool()->release(t_flit);
                 } else {
                     // No space available- Place tail flit in stall queue and
                     // set up a callback for when protocol buffer is dequeued.
@@ -260,15 +260,15 @@ NetworkInterface::wakeup()
                 }
             } else {
                 // Non-tail flit. Send back a credit but not VC free signal.
-                Credit *cFlit = new Credit(t_flit->get_vc(), false,
-                                               curTick());
+                Credit *cFlit = m_net_ptr->getFlitPool()->
+                    allocCredit(t_flit->get_vc(), false, curTick());
                 // Simply send a credit back since we are not buffering
                 // this flit in the NI
                 iPort->sendCredit(cFlit);
 
-                // Update stats and delete flit pointer.
+                // Update stats and release flit pointer.
                 incrementStats(t_flit);
-                delete t_flit;
+                m_net_ptr->getFlitPool()->release(t_flit);
             }
         }
     }
@@ -284,7 +284,7 @@ NetworkInterface::wakeup()
                 outVcState[t_credit->get_vc()].setState(IDLE_,
                     curTick());
             }
-            delete t_credit;
+            m_net_ptr->getFlitPool()->release(t_credit);
         }
     }
 
@@ -329,16 +329,16 @@ NetworkInterface::checkStallQueue()
 
                     // Send back a credit with free signal now that the
                     // VC is no longer stalled.
-                    Credit *cFlit = new Credit(stallFlit->get_vc(), true,
-                                                   curTick());
+                    Credit *cFlit = m_net_ptr->getFlitPool()->
+                        allocCredit(stallFlit->get_vc(), true, curTick());
                     iPort->sendCredit(cFlit);
 
                     // Update Stats
                     incrementStats(stallFlit);
 
-                    // Flit can now safely be deleted and removed from stall
-                    // queue
-                    delete stallFlit;
+                    // Flit can now safely be released and removed from
+                    // stall queue
+                    m_net_ptr->getFlitPool()->release(stallFlit);
                     iPort->m_stall_queue.erase(stallIter);
                     m_stall_count[vnet]--;
 
@@ -430,7 +430,8 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         m_net_ptr->increment_injected_packets(vnet);
         for (int i = 0; i < num_flits; i++) {
             m_net_ptr->increment_injected_flits(vnet);
-            flit *fl = new flit(i, vc, vnet, route, num_flits, new_msg_ptr,
+            flit *fl = m_net_ptr->getFlitPool()->
+                allocFlit(i, vc, vnet, route, num_flits, new_msg_ptr,
                 m_net_ptr->MessageSizeType_to_int(
                 net_msg_ptr->getMessageSize()),
                 oPort->bitWidth(), curTick());
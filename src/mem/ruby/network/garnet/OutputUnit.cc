@@ -130,7 +130,7 @@ OutputUnit::wakeup()
         if (t_credit->is_free_signal())
             set_vc_state(IDLE_, t_credit->get_vc(), curTick());
 
-        delete t_credit;
+        m_router->get_net_ptr()->getFlitPool()->release(t_credit);
 
         if (m_credit_link->isReady(curTick())) {
             scheduleEvent(Cycles(1));
@@ -152,7 +152,8 @@ Router::getInportDirection(int inport)
 }
 
 int
-Router::route_compute(RouteInfo route, int inport, PortDirection inport_dirn)
+Router::route_compute(const RouteInfo &route, int inport,
+                      PortDirection inport_dirn)
 {
     return routingUnit.outportCompute(route, inport, inport_dirn);
 }
@@ -163,6 +164,12 @@ Router::grant_switch(int inport, flit *t_flit)
     crossbarSwitch.update_sw_winner(inport, t_flit);
 }
 
+void
+Router::mark_vc_active(int inport, int invc)
+{
+    switchAllocator.mark_vc_active(inport, invc);
+}
+
 void
 Router::schedule_wakeup(Cycles time)
 {
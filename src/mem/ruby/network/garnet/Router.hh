@@ -106,8 +106,10 @@ class Router : public BasicRouter, public Consumer
     PortDirection getOutportDirection(int outport);
     PortDirection getInportDirection(int inport);
 
-    int route_compute(RouteInfo route, int inport, PortDirection direction);
+    int route_compute(const RouteInfo &route, int inport,
+                      PortDirection direction);
     void grant_switch(int inport, flit *t_flit);
+    void mark_vc_active(int inport, int invc);
     void schedule_wakeup(Cycles time);
 
     std::string getPortDirectionName(PortDirection direction);
@@ -37,6 +37,7 @@
 #include "mem/ruby/slicc_interface/Message.hh"
 
 RoutingUnit::RoutingUnit(Router *router)
+    : m_num_nodes(0)
 {
     m_router = router;
     m_routing_table.clear();
@@ -46,6 +47,9 @@ RoutingUnit::RoutingUnit(Router *router)
 void
 RoutingUnit::addRoute(std::vector<NetDest>& routing_table_entry)
 {
+    // The unicast table is rebuilt on its next use
+    m_unicast_start.clear();
+
     if (routing_table_entry.size() > m_routing_table.size()) {
         m_routing_table.resize(routing_table_entry.size());
     }
@@ -84,8 +88,13 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
+    // Single destination messages use the precomputed table
+    NodeID dest;
+    if (msg_destination.singleElement(dest))
+        return lookupUnicastTable(vnet, dest);
+
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
     // (to make sure different packets don't choose different routes)
@@ -125,13 +134,81 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
         exit(0);
     }
 
+    output_link = selectCandidate(vnet, output_link_candidates.data(),
+                                  num_candidates);
+    return output_link;
+}
+
+int
+RoutingUnit::selectCandidate(int vnet, const int *candidates,
+                             int num_candidates)
+{
     // Randomly select any candidate output link
     int candidate = 0;
     if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
         candidate = rand() % num_candidates;
 
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+    return candidates[candidate];
+}
+
+int
+RoutingUnit::lookupUnicastTable(int vnet, NodeID dest)
+{
+    if (m_unicast_start.empty())
+        buildUnicastTable();
+
+    assert(vnet < m_routing_table.size() && dest < m_num_nodes);
+    const int entry = vnet * m_num_nodes + dest;
+    const int start = m_unicast_start[entry];
+    const int num_candidates = m_unicast_start[entry + 1] - start;
+
+    if (num_candidates == 0) {
+        fatal("Fatal Error:: No Route exists from this Router.");
+        exit(0);
+    }
+
+    return selectCandidate(vnet, &m_unicast_links[start], num_candidates);
+}
+
+void
+RoutingUnit::buildUnicastTable()
+{
+    m_num_nodes = MachineType_base_number(MachineType_NUM);
+
+    // Candidate links of minimum weight for each destination, in
+    // increasing link order as in lookupRoutingTable
+    std::vector<std::vector<int>> candidates(m_num_nodes);
+    std::vector<int> min_weight(m_num_nodes);
+
+    m_unicast_start.assign(m_routing_table.size() * m_num_nodes + 1, 0);
+    m_unicast_links.clear();
+
+    for (int vnet = 0; vnet < m_routing_table.size(); vnet++) {
+        for (auto &c : candidates)
+            c.clear();
+        std::fill(min_weight.begin(), min_weight.end(), INFINITE_);
+
+        for (int link = 0; link < m_routing_table[vnet].size(); link++) {
+            NetDest link_dest = m_routing_table[vnet][link];
+            for (NodeID dest : link_dest.getAllDest()) {
+                if (m_weight_table[link] < min_weight[dest]) {
+                    min_weight[dest] = m_weight_table[link];
+                    candidates[dest].clear();
+                }
+                if (m_weight_table[link] == min_weight[dest])
+                    candidates[dest].push_back(link);
+            }
+        }
+
+        for (int dest = 0; dest < m_num_nodes; dest++) {
+            m_unicast_start[vnet * m_num_nodes + dest] =
+                m_unicast_links.size();
+            m_unicast_links.insert(m_unicast_links.end(),
+                                   candidates[dest].begin(),
+                                   candidates[dest].end());
+        }
+    }
+    m_unicast_start.back() = m_unicast_links.size();
 }
 
 
@@ -156,7 +233,7 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 // table is provided here.
 
 int
-RoutingUnit::outportCompute(RouteInfo route, int inport,
+RoutingUnit::outportCompute(const RouteInfo &route, int inport,
                             PortDirection inport_dirn)
 {
     int outport = -1;
@@ -166,7 +243,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
+        outport = lookupUnicastTable(route.vnet, route.dest_ni);
         return outport;
     }
 
@@ -177,14 +254,14 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 
     switch (routing_algorithm) {
         case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupUnicastTable(route.vnet, route.dest_ni); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
         default: outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupUnicastTable(route.vnet, route.dest_ni); break;
     }
 
     assert(outport != -1);
@@ -195,7 +272,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
 int
-RoutingUnit::outportComputeXY(RouteInfo route,
+RoutingUnit::outportComputeXY(const RouteInfo &route,
                               int inport,
                               PortDirection inport_dirn)
 {
@@ -253,7 +330,7 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
-RoutingUnit::outportComputeCustom(RouteInfo route,
+RoutingUnit::outportComputeCustom(const RouteInfo &route,
                                  int inport,
                                  PortDirection inport_dirn)
 {
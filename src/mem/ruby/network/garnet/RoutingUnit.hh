@@ -44,7 +44,7 @@ class RoutingUnit
 {
   public:
     RoutingUnit(Router *router);
-    int outportCompute(RouteInfo route,
+    int outportCompute(const RouteInfo &route,
                       int inport,
                       PortDirection inport_dirn);
 
@@ -53,19 +53,22 @@ class RoutingUnit
     void addWeight(int link_weight);
 
     // get output port from routing table
-    int  lookupRoutingTable(int vnet, NetDest net_dest);
+    int  lookupRoutingTable(int vnet, const NetDest &net_dest);
+
+    // get output port from routing table for a single destination node
+    int  lookupUnicastTable(int vnet, NodeID dest);
 
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
 
     // Routing for Mesh
-    int outportComputeXY(RouteInfo route,
+    int outportComputeXY(const RouteInfo &route,
                          int inport,
                          PortDirection inport_dirn);
 
     // Custom Routing Algorithm using Port Directions
-    int outportComputeCustom(RouteInfo route,
+    int outportComputeCustom(const RouteInfo &route,
                              int inport,
                              PortDirection inport_dirn);
 
@@ -75,12 +78,26 @@ class RoutingUnit
 
 
   private:
+    // Build the per destination candidate lists from the routing table
+    void buildUnicastTable();
+
+    // Pick one of the candidate output links
+    int selectCandidate(int vnet, const int *candidates, int num_candidates);
+
     Router *m_router;
 
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
+    // Output link candidates of minimum weight for each vnet and
+    // destination node, precomputed from the routing table on first
+    // use. The candidates for (vnet, node) are m_unicast_links
+    // [m_unicast_start[vnet * m_num_nodes + node], ... + 1].
+    int m_num_nodes;
+    std::vector<int> m_unicast_start;
+    std::vector<int> m_unicast_links;
+
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
@@ -31,6 +31,9 @@
 
 #include "mem/ruby/network/garnet/SwitchAllocator.hh"
 
+#include <algorithm>
+
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet/InputUnit.hh"
@@ -46,6 +49,9 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+
+    m_vc_mask_words = (m_num_vcs + 63) / 64;
+    m_total_active_vcs = 0;
 }
 
 void
@@ -57,6 +63,10 @@ SwitchAllocator::init()
     m_round_robin_invc.resize(m_num_inports);
     m_port_requests.resize(m_num_outports);
     m_vc_winners.resize(m_num_outports);
+    m_active_vcs.assign(m_num_inports * m_vc_mask_words, 0);
+    m_num_active_vcs.assign(m_num_inports, 0);
+    m_outport_requested.assign(m_num_outports, false);
+    m_requested_outports.reserve(m_num_outports);
 
     for (int i = 0; i < m_num_inports; i++) {
         m_round_robin_invc[i] = 0;
@@ -86,6 +96,10 @@ SwitchAllocator::init()
 void
 SwitchAllocator::wakeup()
 {
+    // Nothing is buffered in any input VC
+    if (m_total_active_vcs == 0)
+        return;
+
     arbitrate_inports(); // First stage of allocation
     arbitrate_outports(); // Second stage of allocation
 
@@ -108,12 +122,17 @@ SwitchAllocator::arbitrate_inports()
 {
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
+    // Only the VCs holding flits are visited, in the same round robin
+    // order as a scan over all VCs, as empty VCs never need SA.
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
+        const int num_active = m_num_active_vcs[inport];
+        if (num_active == 0)
+            continue;
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        auto input_unit = m_router->getInputUnit(inport);
+        int invc = next_active_vc(inport, m_round_robin_invc[inport]);
 
+        for (int invc_iter = 0; invc_iter < num_active; invc_iter++) {
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
 
@@ -130,13 +149,16 @@ SwitchAllocator::arbitrate_inports()
                     m_port_requests[outport][inport] = true;
                     m_vc_winners[outport][inport]= invc;
 
+                    if (!m_outport_requested[outport]) {
+                        m_outport_requested[outport] = true;
+                        m_requested_outports.push_back(outport);
+                    }
+
                     break; // got one vc winner for this port
                 }
             }
 
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
+            invc = next_active_vc(inport, invc + 1);
         }
     }
 }
@@ -161,7 +183,9 @@ SwitchAllocator::arbitrate_outports()
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
-    for (int outport = 0; outport < m_num_outports; outport++) {
+    // Only outports that received a request are visited, in port order.
+    std::sort(m_requested_outports.begin(), m_requested_outports.end());
+    for (int outport : m_requested_outports) {
         int inport = m_round_robin_inport[outport];
 
         for (int inport_iter = 0; inport_iter < m_num_inports;
@@ -183,6 +207,8 @@ SwitchAllocator::arbitrate_outports()
 
                 // remove flit from Input VC
                 flit *t_flit = input_unit->getTopFlit(invc);
+                if (input_unit->isEmpty(invc))
+                    clear_vc_active(inport, invc);
 
                 DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
                                      "granted outvc %d at outport %d "
@@ -359,11 +385,17 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+        if (m_num_active_vcs[i] == 0)
+            continue;
+
+        auto input_unit = m_router->getInputUnit(i);
+        int j = next_active_vc(i, 0);
+        for (int n = 0; n < m_num_active_vcs[i]; n++) {
+            if (input_unit->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
+            j = next_active_vc(i, j + 1);
         }
     }
 }
@@ -382,11 +414,56 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
-    for (int i = 0; i < m_num_outports; i++) {
-        for (int j = 0; j < m_num_inports; j++) {
-            m_port_requests[i][j] = false;
-        }
+    for (int outport : m_requested_outports) {
+        std::fill(m_port_requests[outport].begin(),
+                  m_port_requests[outport].end(), false);
+        m_outport_requested[outport] = false;
+    }
+    m_requested_outports.clear();
+}
+
+void
+SwitchAllocator::mark_vc_active(int inport, int invc)
+{
+    uint64_t &word = m_active_vcs[inport * m_vc_mask_words + invc / 64];
+    const uint64_t bit = 1ULL << (invc % 64);
+    if (!(word & bit)) {
+        word |= bit;
+        m_num_active_vcs[inport]++;
+        m_total_active_vcs++;
+    }
+}
+
+void
+SwitchAllocator::clear_vc_active(int inport, int invc)
+{
+    uint64_t &word = m_active_vcs[inport * m_vc_mask_words + invc / 64];
+    const uint64_t bit = 1ULL << (invc % 64);
+    if (word & bit) {
+        word &= ~bit;
+        m_num_active_vcs[inport]--;
+        m_total_active_vcs--;
+    }
+}
+
+int
+SwitchAllocator::next_active_vc(int inport, int invc) const
+{
+    const uint64_t *mask = &m_active_vcs[inport * m_vc_mask_words];
+    if (invc >= m_num_vcs)
+        invc = 0;
+
+    // Search from invc to the end of the mask, then wrap around to the
+    // bits below invc in its own word.
+    int word = invc / 64;
+    uint64_t bits = mask[word] & (~0ULL << (invc % 64));
+    for (int i = 0; i <= m_vc_mask_words; i++) {
+        if (bits)
+            return word * 64 + findLsbSet(bits);
+        word = (word + 1 == m_vc_mask_words) ? 0 : word + 1;
+        bits = mask[word];
     }
+    return -1;
 }
 
 void
@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_SWITCHALLOCATOR_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_SWITCHALLOCATOR_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -57,6 +58,13 @@ class SwitchAllocator : public Consumer
     bool send_allowed(int inport, int invc, int outport, int outvc);
     int vc_allocate(int outport, int inport, int invc);
 
+    /**
+     * Record that an input VC holds flits. Called by the InputUnit each
+     * time it buffers a flit; the allocator clears the bit again once it
+     * drains the VC, so that arbitration only visits VCs with work.
+     */
+    void mark_vc_active(int inport, int invc);
+
     inline double
     get_input_arbiter_activity()
     {
@@ -81,6 +89,23 @@ class SwitchAllocator : public Consumer
     std::vector<int> m_round_robin_inport;
     std::vector<std::vector<bool>> m_port_requests;
     std::vector<std::vector<int>> m_vc_winners; // a list for each outport
+
+    /**
+     * First active VC of an inport at or after invc in round robin
+     * order, or -1 if the inport has no buffered flits.
+     */
+    int next_active_vc(int inport, int invc) const;
+    void clear_vc_active(int inport, int invc);
+
+    // Bitmask of the input VCs holding flits, m_vc_mask_words per inport
+    std::vector<uint64_t> m_active_vcs;
+    int m_vc_mask_words;
+    std::vector<int> m_num_active_vcs; // per inport
+    int m_total_active_vcs;
+
+    // Outports that received a request in SA-I this cycle
+    std::vector<int> m_requested_outports;
+    std::vector<bool> m_outport_requested;
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET_0_SWITCHALLOCATOR_HH__
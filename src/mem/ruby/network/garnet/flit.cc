@@ -32,10 +32,19 @@
 
 #include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 
 // Constructor for the flit
 flit::flit(int id, int  vc, int vnet, RouteInfo route, int size,
     MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
+{
+    reset(id, vc, vnet, route, size, msg_ptr, MsgSize, bWidth, curTime);
+}
+
+void
+flit::reset(int id, int vc, int vnet, const RouteInfo &route, int size,
+            const MsgPtr &msg_ptr, int MsgSize, uint32_t bWidth,
+            Tick curTime)
 {
     m_size = size;
     m_msg_ptr = msg_ptr;
@@ -64,7 +73,7 @@ flit::flit(int id, int  vc, int vnet, RouteInfo route, int size,
 }
 
 flit *
-flit::serialize(int ser_id, int parts, uint32_t bWidth)
+flit::serialize(int ser_id, int parts, uint32_t bWidth, FlitPool *pool)
 {
     assert(m_width > bWidth);
 
@@ -73,7 +82,7 @@ flit::serialize(int ser_id, int parts, uint32_t bWidth)
     int new_size = (int)divCeil((float)msgSize, (float)bWidth);
     assert(new_id < new_size);
 
-    flit *fl = new flit(new_id, m_vc, m_vnet, m_route,
+    flit *fl = pool->allocFlit(new_id, m_vc, m_vnet, m_route,
                     new_size, m_msg_ptr, msgSize, bWidth, m_time);
     fl->set_enqueue_time(m_enqueue_time);
     fl->set_src_delay(src_delay);
@@ -81,14 +90,15 @@ flit::serialize(int ser_id, int parts, uint32_t bWidth)
 }
 
 flit *
-flit::deserialize(int des_id, int num_flits, uint32_t bWidth)
+flit::deserialize(int des_id, int num_flits, uint32_t bWidth,
+                  FlitPool *pool)
 {
     int ratio = (int)divCeil((float)bWidth, (float)m_width);
     int new_id = ((int)divCeil((float)(m_id+1), (float)ratio)) - 1;
     int new_size = (int)divCeil((float)msgSize, (float)bWidth);
     assert(new_id < new_size);
 
-    flit *fl = new flit(new_id, m_vc, m_vnet, m_route,
+    flit *fl = pool->allocFlit(new_id, m_vc, m_vnet, m_route,
                     new_size, m_msg_ptr, msgSize, bWidth, m_time);
     fl->set_enqueue_time(m_enqueue_time);
     fl->set_src_delay(src_delay);
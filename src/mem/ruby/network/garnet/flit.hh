@@ -38,6 +38,8 @@
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
+class FlitPool;
+
 class flit
 {
   public:
@@ -47,6 +49,14 @@ class flit
 
     virtual ~flit(){};
 
+    /**
+     * Re-initialize a flit recycled by the FlitPool, as if it had just
+     * been constructed with these arguments.
+     */
+    void reset(int id, int vc, int vnet, const RouteInfo &route, int size,
+               const MsgPtr &msg_ptr, int MsgSize, uint32_t bWidth,
+               Tick curTime);
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -55,7 +65,7 @@ class flit
     Tick get_time() { return m_time; }
     int get_vnet() { return m_vnet; }
     int get_vc() { return m_vc; }
-    RouteInfo get_route() { return m_route; }
+    const RouteInfo &get_route() const { return m_route; }
     MsgPtr& get_msg_ptr() { return m_msg_ptr; }
     flit_type get_type() { return m_type; }
     std::pair<flit_stage, Tick> get_stage() { return m_stage; }
@@ -99,8 +109,10 @@ class flit
 
     bool functionalWrite(Packet *pkt);
 
-    virtual flit* serialize(int ser_id, int parts, uint32_t bWidth);
-    virtual flit* deserialize(int des_id, int num_flits, uint32_t bWidth);
+    virtual flit* serialize(int ser_id, int parts, uint32_t bWidth,
+                            FlitPool *pool);
+    virtual flit* deserialize(int des_id, int num_flits, uint32_t bWidth,
+                              FlitPool *pool);
 
     uint32_t m_width;
     int msgSize;
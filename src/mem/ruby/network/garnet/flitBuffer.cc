@@ -31,12 +31,16 @@
 
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
+#include <algorithm>
+
 flitBuffer::flitBuffer()
+    : m_head(0), m_size(0), m_mask(0)
 {
     max_size = INFINITE_;
 }
 
 flitBuffer::flitBuffer(int maximum_size)
+    : m_head(0), m_size(0), m_mask(0)
 {
     max_size = maximum_size;
 }
@@ -44,13 +48,13 @@ flitBuffer::flitBuffer(int maximum_size)
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_size == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_size != 0) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -61,13 +65,13 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_size << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (m_size >= max_size);
 }
 
 void
@@ -76,13 +80,26 @@ flitBuffer::setMaxSize(int maximum)
     max_size = maximum;
 }
 
+void
+flitBuffer::grow()
+{
+    std::vector<flit *> buffer(std::max<size_t>(4, 2 * m_buffer.size()));
+    for (int i = 0; i < m_size; i++) {
+        buffer[i] = m_buffer[(m_head + i) & m_mask];
+    }
+
+    m_buffer.swap(buffer);
+    m_head = 0;
+    m_mask = m_buffer.size() - 1;
+}
+
 uint32_t
 flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (int i = 0; i < m_size; ++i) {
+        if (m_buffer[(m_head + i) & m_mask]->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
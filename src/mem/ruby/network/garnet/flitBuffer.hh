@@ -31,7 +31,6 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
-#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -49,34 +48,59 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_size; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        std::pop_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
-        m_buffer.pop_back();
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & m_mask;
+        m_size--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        return m_buffer[m_head];
     }
 
+    /**
+     * Insert a flit, keeping the buffer sorted by (time, id). Flits
+     * nearly always arrive in that order, which makes this an append to
+     * the ring; an early flit is moved back past the later ones. Flits
+     * with the same time and id leave in the order they were inserted.
+     */
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
-        std::push_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
+        if (m_size == (int)m_buffer.size())
+            grow();
+
+        int pos = m_size;
+        while (pos > 0) {
+            flit *prev = m_buffer[(m_head + pos - 1) & m_mask];
+            if (!flit::greater(prev, flt))
+                break;
+            m_buffer[(m_head + pos) & m_mask] = prev;
+            pos--;
+        }
+        m_buffer[(m_head + pos) & m_mask] = flt;
+        m_size++;
     }
 
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    /** Double the ring capacity, which is never given back. */
+    void grow();
+
+    // Ring of flits in (time, id, insertion) order, with a power-of-two
+    // capacity
     std::vector<flit *> m_buffer;
+    int m_head;
+    int m_size;
+    int m_mask;
     int max_size;
 };
 
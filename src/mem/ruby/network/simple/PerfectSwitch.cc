@@ -95,6 +95,27 @@ PerfectSwitch::addOutPort(const vector<MessageBuffer*>& out,
     // Add to routing table
     m_out.push_back(out);
     m_routing_table.push_back(routing_table_entry);
+
+    // The unicast table is rebuilt on its next use
+    m_unicast_table.clear();
+}
+
+int
+PerfectSwitch::unicastLink(NodeID dest)
+{
+    if (m_unicast_table.empty()) {
+        m_unicast_table.assign(MachineType_base_number(MachineType_NUM), -1);
+        for (int link = 0; link < m_routing_table.size(); link++) {
+            NetDest link_dest = m_routing_table[link];
+            for (NodeID node : link_dest.getAllDest()) {
+                if (m_unicast_table[node] == -1)
+                    m_unicast_table[node] = link;
+            }
+        }
+    }
+
+    assert(dest < m_unicast_table.size());
+    return m_unicast_table[dest];
 }
 
 PerfectSwitch::~PerfectSwitch()
@@ -157,7 +178,7 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
 
         output_links.clear();
         output_link_destinations.clear();
-        NetDest msg_dsts = net_msg_ptr->getDestination();
+        const NetDest &msg_dest = net_msg_ptr->getDestination();
 
         // Unfortunately, the token-protocol sends some
         // zero-destination messages, so this assert isn't valid
@@ -192,31 +213,47 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
             }
         }
 
-        for (int i = 0; i < m_routing_table.size(); i++) {
-            // pick the next link to look at
-            int link = m_link_order[i].m_link;
-            NetDest dst = m_routing_table[link];
-            DPRINTF(RubyNetwork, "dst: %s\n", dst);
-
-            if (!msg_dsts.intersectionIsNotEmpty(dst))
-                continue;
-
-            // Remember what link we're using
+        // Links are tried in their original order unless adaptive
+        // routing reordered them, in which case the first link leading
+        // to a single destination is known in advance
+        NodeID unicast_dest;
+        if ((!m_network_ptr->getAdaptiveRouting() ||
+             m_network_ptr->isVNetOrdered(vnet)) &&
+            msg_dest.singleElement(unicast_dest)) {
+            const int link = unicastLink(unicast_dest);
+            assert(link >= 0);
             output_links.push_back(link);
+            output_link_destinations.push_back(msg_dest);
+        } else {
+            NetDest msg_dsts = msg_dest;
+
+            for (int i = 0; i < m_routing_table.size(); i++) {
+                // pick the next link to look at
+                int link = m_link_order[i].m_link;
+                const NetDest &dst = m_routing_table[link];
+                DPRINTF(RubyNetwork, "dst: %s\n", dst);
+
+                if (!msg_dsts.intersectionIsNotEmpty(dst))
+                    continue;
+
+                // Remember what link we're using
+                output_links.push_back(link);
+
+                // Need to remember which destinations need this message
+                // in another vector.  This Set is the intersection of the
+                // routing_table entry and the current destination set.
+                // The intersection must not be empty, since we are inside
+                // "if"
+                output_link_destinations.push_back(msg_dsts.AND(dst));
+
+                // Next, we update the msg_destination not to include
+                // those nodes that were already handled by this link
+                msg_dsts.removeNetDest(dst);
+            }
 
-            // Need to remember which destinations need this message in
-            // another vector.  This Set is the intersection of the
-            // routing_table entry and the current destination set.  The
-            // intersection must not be empty, since we are inside "if"
-            output_link_destinations.push_back(msg_dsts.AND(dst));
-
-            // Next, we update the msg_destination not to include
-            // those nodes that were already handled by this link
-            msg_dsts.removeNetDest(dst);
+            assert(msg_dsts.count() == 0);
         }
 
-        assert(msg_dsts.count() == 0);
-
         // Check for resources - for all outgoing queues
         bool enough = true;
         for (int i = 0; i < output_links.size(); i++) {
@@ -88,6 +88,10 @@ class PerfectSwitch : public Consumer
     void operateVnet(int vnet);
     void operateMessageBuffer(MessageBuffer *b, int incoming, int vnet);
 
+    // Output link for a single destination node when links are tried in
+    // order, -1 if no link leads to it
+    int unicastLink(NodeID dest);
+
     const SwitchID m_switch_id;
     Switch * const m_switch;
 
@@ -98,6 +102,10 @@ class PerfectSwitch : public Consumer
     std::vector<NetDest> m_routing_table;
     std::vector<LinkOrder> m_link_order;
 
+    // First output link leading to each destination node, precomputed
+    // from the routing table on first use
+    std::vector<int> m_unicast_table;
+
     uint32_t m_virtual_networks;
     int m_round_robin_start;
     int m_wakeups_wo_switch;
@@ -43,7 +43,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -182,6 +181,13 @@ class CacheMemory : public SimObject
     // convert a Address to its location in the cache
     int64_t addressToCacheSet(Addr address) const;
 
+    // Index of a (set, way) pair in the flat tag and entry arrays.
+    int
+    flatIndex(int64_t cacheSet, int way) const
+    {
+        return cacheSet * m_cache_assoc + way;
+    }
+
     // Given a cache tag: returns the index of the tag in a set.
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
@@ -195,10 +201,15 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    /**
+     * Set-indexed tag and entry arrays, both laid out flat with the ways
+     * of a set stored contiguously (see flatIndex()). Lookups only scan
+     * the packed tags of the target set and touch the entry pointer on a
+     * hit. Ways that do not hold an entry are tagged with MaxAddr, which
+     * can never be a line address.
+     */
+    std::vector<Addr> m_tags;
+    std::vector<AbstractCacheEntry*> m_cache;
 
     /**
      * We use BaseReplacementPolicy from Classic system here, hence we can use
@@ -0,0 +1,262 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_FIXEDADDRMAP_HH__
+#define __MEM_RUBY_STRUCTURES_FIXEDADDRMAP_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/ruby/common/Address.hh"
+
+/**
+ * A fixed-capacity map from line addresses to entries, used for the
+ * bounded per-controller bookkeeping structures (TBEs, outstanding
+ * sequencer requests) that are looked up on every miss.
+ *
+ * All entries are preallocated when the map is built and never move, so
+ * pointers and references to an entry stay valid until it is
+ * deallocated, even if other entries are allocated or freed in the
+ * meantime. Entries are located through an open-addressing (linear
+ * probing) index which is kept at most half full; deletion uses backward
+ * shifting, so there are no tombstones and lookups never degrade.
+ * Neither allocation nor deallocation touch the heap.
+ */
+template<class ENTRY>
+class FixedAddrMap
+{
+  private:
+    /** Index of the entry stored in an index slot, -1 if empty. */
+    typedef int EntryIdx;
+
+  public:
+    /**
+     * Pair-like view of a map element as produced by iteration.
+     */
+    typedef std::pair<const Addr &, ENTRY &> value_type;
+
+    template<class MAP, class VALUE>
+    class IteratorBase
+    {
+      public:
+        IteratorBase(MAP *map, int slot)
+            : map(map), slot(slot)
+        {
+            skipEmpty();
+        }
+
+        VALUE
+        operator*() const
+        {
+            const EntryIdx idx = map->m_slots[slot];
+            return VALUE(map->m_keys[idx], map->m_entries[idx]);
+        }
+
+        IteratorBase &
+        operator++()
+        {
+            ++slot;
+            skipEmpty();
+            return *this;
+        }
+
+        bool
+        operator==(const IteratorBase &other) const
+        {
+            return map == other.map && slot == other.slot;
+        }
+
+        bool
+        operator!=(const IteratorBase &other) const
+        {
+            return !(*this == other);
+        }
+
+      private:
+        void
+        skipEmpty()
+        {
+            while (slot < (int)map->m_slots.size() &&
+                   map->m_slots[slot] < 0)
+                ++slot;
+        }
+
+        MAP *map;
+        int slot;
+    };
+
+    typedef IteratorBase<FixedAddrMap, value_type> iterator;
+    typedef IteratorBase<const FixedAddrMap,
+                         std::pair<const Addr &, const ENTRY &>>
+        const_iterator;
+
+    /**
+     * @param capacity Maximum number of entries held at any time.
+     * @param init Value every entry is reset to when allocated. Entries
+     *             are copy-assigned from it, which lets entry types that
+     *             own buffers reuse them instead of reallocating.
+     */
+    explicit FixedAddrMap(int capacity, const ENTRY &init = ENTRY())
+        : m_init(init), m_entries(capacity, init), m_keys(capacity, 0),
+          m_slots(2 << ceilLog2(std::max(capacity, 1)), -1),
+          m_mask(m_slots.size() - 1), m_size(0)
+    {
+        assert(capacity > 0);
+        m_free.reserve(capacity);
+        for (int i = capacity - 1; i >= 0; --i)
+            m_free.push_back(i);
+    }
+
+    int size() const { return m_size; }
+    int capacity() const { return m_entries.size(); }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_free.empty(); }
+
+    bool isPresent(Addr address) const { return findSlot(address) >= 0; }
+
+    ENTRY *
+    lookup(Addr address)
+    {
+        const int slot = findSlot(address);
+        return slot < 0 ? nullptr : &m_entries[m_slots[slot]];
+    }
+
+    const ENTRY *
+    lookup(Addr address) const
+    {
+        const int slot = findSlot(address);
+        return slot < 0 ? nullptr : &m_entries[m_slots[slot]];
+    }
+
+    /**
+     * Allocate a new entry for an address that is not in the map yet.
+     * The entry is reset to the initial value given at construction.
+     */
+    ENTRY &
+    allocate(Addr address)
+    {
+        assert(!isPresent(address));
+        panic_if(full(), "Fixed address map of %d entries is full.\n",
+                 capacity());
+
+        const EntryIdx idx = m_free.back();
+        m_free.pop_back();
+
+        int slot = home(address);
+        while (m_slots[slot] >= 0)
+            slot = (slot + 1) & m_mask;
+        m_slots[slot] = idx;
+        m_keys[idx] = address;
+        ++m_size;
+
+        m_entries[idx] = m_init;
+        return m_entries[idx];
+    }
+
+    void
+    deallocate(Addr address)
+    {
+        int hole = findSlot(address);
+        assert(hole >= 0);
+
+        m_free.push_back(m_slots[hole]);
+        --m_size;
+
+        // Shift back any entry in the probe sequence after the freed
+        // slot whose home slot does not lie between the two, so that
+        // every entry stays reachable from its home slot.
+        int slot = hole;
+        while (true) {
+            slot = (slot + 1) & m_mask;
+            const EntryIdx idx = m_slots[slot];
+            if (idx < 0)
+                break;
+            const int dist_home = (slot - home(m_keys[idx])) & m_mask;
+            const int dist_hole = (slot - hole) & m_mask;
+            if (dist_home >= dist_hole) {
+                m_slots[hole] = idx;
+                hole = slot;
+            }
+        }
+        m_slots[hole] = -1;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_slots.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator
+    end() const
+    {
+        return const_iterator(this, m_slots.size());
+    }
+
+  private:
+    int
+    home(Addr address) const
+    {
+        // Fibonacci hashing; line addresses have their low bits clear so
+        // the top bits of the product are used.
+        const uint64_t hash = address * 0x9e3779b97f4a7c15ULL;
+        return (hash >> 32) & m_mask;
+    }
+
+    int
+    findSlot(Addr address) const
+    {
+        int slot = home(address);
+        while (true) {
+            const EntryIdx idx = m_slots[slot];
+            if (idx < 0)
+                return -1;
+            if (m_keys[idx] == address)
+                return slot;
+            slot = (slot + 1) & m_mask;
+        }
+    }
+
+    // Private copy constructor and assignment operator
+    FixedAddrMap(const FixedAddrMap& obj);
+    FixedAddrMap& operator=(const FixedAddrMap& obj);
+
+    const ENTRY m_init;
+
+    /** Entry storage, never resized after construction. */
+    std::vector<ENTRY> m_entries;
+    std::vector<Addr> m_keys;
+    std::vector<EntryIdx> m_free;
+
+    /** Open-addressing index into m_entries. */
+    std::vector<EntryIdx> m_slots;
+    const int m_mask;
+
+    int m_size;
+};
+
+#endif // __MEM_RUBY_STRUCTURES_FIXEDADDRMAP_HH__
@@ -42,16 +42,17 @@
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
 #include <iostream>
-#include <unordered_map>
 
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/structures/FixedAddrMap.hh"
 
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_map(number_of_TBEs), m_number_of_TBEs(number_of_TBEs)
     {
     }
 
@@ -76,7 +77,9 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    // All number_of_TBEs entries are allocated up front, so allocating
+    // and freeing a TBE on a miss does not go through the heap.
+    FixedAddrMap<ENTRY> m_map;
 
   private:
     int m_number_of_TBEs;
@@ -97,7 +100,7 @@ TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
     assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    return m_map.isPresent(address);
 }
 
 template<class ENTRY>
@@ -105,8 +108,9 @@ inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    panic_if(m_map.size() >= m_number_of_TBEs,
+             "All %d TBEs are in use.\n", m_number_of_TBEs);
+    m_map.allocate(address);
 }
 
 template<class ENTRY>
@@ -115,7 +119,7 @@ TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
     assert(m_map.size() > 0);
-    m_map.erase(address);
+    m_map.deallocate(address);
 }
 
 template<class ENTRY>
@@ -130,8 +134,7 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    return m_map.lookup(address);
 }
 
 
@@ -145,9 +145,9 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
+        assert(m_RequestTable.isPresent(address));
 
-        auto &seq_req_list = m_RequestTable[address];
+        auto &seq_req_list = *m_RequestTable.lookup(address);
         while (!seq_req_list.empty()) {
             SequencerRequest &request = seq_req_list.front();
 
@@ -174,7 +174,7 @@ HTMSequencer::htmCallback(Addr address,
         }
         // free all outstanding requests corresponding to this address
         if (seq_req_list.empty()) {
-            m_RequestTable.erase(address);
+            m_RequestTable.deallocate(address);
         }
     } else {
         panic("unrecognised HTM callback mode\n");
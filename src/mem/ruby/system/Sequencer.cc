@@ -61,6 +61,8 @@
 
 using namespace std;
 
+const int Sequencer::htmAbortReserve;
+
 Sequencer *
 RubySequencerParams::create()
 {
@@ -68,7 +70,11 @@ RubySequencerParams::create()
 }
 
 Sequencer::Sequencer(const Params *p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p),
+      m_requestPool(p->max_outstanding_requests + htmAbortReserve),
+      m_RequestTable(p->max_outstanding_requests + htmAbortReserve,
+                     SequencerRequestQueue(&m_requestPool)),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -248,13 +254,20 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
 
     Addr line_addr = makeLineAddress(pkt->getAddr());
     // Check if there is any outstanding request for the same cache line.
-    auto &seq_req_list = m_RequestTable[line_addr];
+    SequencerRequestQueue *seq_req_list = m_RequestTable.lookup(line_addr);
+    if (!seq_req_list) {
+        panic_if(m_RequestTable.full(),
+                 "More than %d HTM aborts outstanding beyond the %d "
+                 "requests allowed.\n",
+                 htmAbortReserve, m_max_outstanding_requests);
+        seq_req_list = &m_RequestTable.allocate(line_addr);
+    }
     // Create a default entry
-    seq_req_list.emplace_back(pkt, primary_type,
+    seq_req_list->emplace_back(pkt, primary_type,
         secondary_type, curCycle());
     m_outstanding_count++;
 
-    if (seq_req_list.size() > 1) {
+    if (seq_req_list->size() > 1) {
         return RequestStatus_Aliased;
     }
 
@@ -354,8 +367,8 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.isPresent(address));
+    auto &seq_req_list = *m_RequestTable.lookup(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -431,7 +444,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
 
     // free all outstanding requests corresponding to this address
     if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.deallocate(address);
     }
 }
 
@@ -447,8 +460,8 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.isPresent(address));
+    auto &seq_req_list = *m_RequestTable.lookup(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -486,7 +499,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
 
     // free all outstanding requests corresponding to this address
     if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.deallocate(address);
     }
 }
 
@@ -736,9 +749,8 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
 std::ostream &
-operator<<(ostream &out, const std::unordered_map<KEY, VALUE> &map)
+operator<<(ostream &out, const FixedAddrMap<SequencerRequestQueue> &map)
 {
     for (const auto &table_entry : map) {
         out << "[ " << table_entry.first << " =";
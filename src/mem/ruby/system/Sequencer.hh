@@ -41,15 +41,17 @@
 #ifndef __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
+#include <deque>
 #include <iostream>
-#include <list>
-#include <unordered_map>
+#include <vector>
 
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/MachineType.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
+#include "mem/ruby/structures/FixedAddrMap.hh"
 #include "mem/ruby/system/RubyPort.hh"
 #include "params/RubySequencer.hh"
 
@@ -77,6 +79,149 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+/**
+ * Storage for the outstanding SequencerRequests of a Sequencer. The number
+ * of requests is normally bounded by the sequencer's
+ * max_outstanding_requests, so that many are created up front and
+ * recycled through a free list. HTM abort requests may exceed the bound;
+ * if the free list runs dry the pool grows, and the nodes it already
+ * handed out stay where they are.
+ */
+class SequencerRequestPool
+{
+  public:
+    struct Node
+    {
+        SequencerRequest req;
+        Node *next;
+    };
+
+    explicit SequencerRequestPool(int capacity)
+        : freeList(nullptr)
+    {
+        for (int i = 0; i < capacity; ++i)
+            grow();
+    }
+
+    Node *
+    alloc(const SequencerRequest &req)
+    {
+        if (!freeList)
+            grow();
+        Node *node = freeList;
+        freeList = node->next;
+        node->req = req;
+        node->next = nullptr;
+        return node;
+    }
+
+    void
+    free(Node *node)
+    {
+        node->req.pkt = nullptr;
+        node->next = freeList;
+        freeList = node;
+    }
+
+  private:
+    void
+    grow()
+    {
+        nodes.push_back(Node{SequencerRequest(nullptr, RubyRequestType_NULL,
+                                              RubyRequestType_NULL,
+                                              Cycles(0)),
+                             freeList});
+        freeList = &nodes.back();
+    }
+
+    // A deque, as its elements do not move when it grows.
+    std::deque<Node> nodes;
+    Node *freeList;
+};
+
+/**
+ * FIFO of the requests outstanding for a single cache line, in the order
+ * they were issued. Requests live in a SequencerRequestPool shared by
+ * all the lines of a Sequencer; references to a request stay valid until
+ * it is popped.
+ */
+class SequencerRequestQueue
+{
+  public:
+    class const_iterator
+    {
+      public:
+        explicit const_iterator(const SequencerRequestPool::Node *node)
+            : node(node)
+        {}
+
+        const SequencerRequest &operator*() const { return node->req; }
+        const_iterator &
+        operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+        bool
+        operator!=(const const_iterator &other) const
+        {
+            return node != other.node;
+        }
+
+      private:
+        const SequencerRequestPool::Node *node;
+    };
+
+    explicit SequencerRequestQueue(SequencerRequestPool *pool = nullptr)
+        : pool(pool), head(nullptr), tail(nullptr), count(0)
+    {}
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    SequencerRequest &
+    front()
+    {
+        assert(head);
+        return head->req;
+    }
+
+    void
+    emplace_back(PacketPtr pkt, RubyRequestType type,
+                 RubyRequestType second_type, Cycles issue_time)
+    {
+        SequencerRequestPool::Node *node = pool->alloc(
+            SequencerRequest(pkt, type, second_type, issue_time));
+        if (tail)
+            tail->next = node;
+        else
+            head = node;
+        tail = node;
+        ++count;
+    }
+
+    void
+    pop_front()
+    {
+        assert(head);
+        SequencerRequestPool::Node *node = head;
+        head = node->next;
+        if (!head)
+            tail = nullptr;
+        --count;
+        pool->free(node);
+    }
+
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(nullptr); }
+
+  private:
+    SequencerRequestPool *pool;
+    SequencerRequestPool::Node *head;
+    SequencerRequestPool::Node *tail;
+    int count;
+};
+
 class Sequencer : public RubyPort
 {
   public:
@@ -199,8 +344,16 @@ class Sequencer : public RubyPort
     Sequencer& operator=(const Sequencer& obj);
 
   protected:
-    // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    // Storage for all outstanding requests, must be constructed before
+    // m_RequestTable
+    SequencerRequestPool m_requestPool;
+
+    // RequestTable contains both read and write requests, handles aliasing.
+    // It has one entry per line with outstanding requests, and so never
+    // holds more than max_outstanding_requests entries plus the HTM aborts
+    // that bypass that limit.
+    typedef FixedAddrMap<SequencerRequestQueue> RequestTable;
+    RequestTable m_RequestTable;
 
     Cycles m_deadlock_threshold;
 
@@ -209,6 +362,11 @@ class Sequencer : public RubyPort
                                         RubyRequestType secondary_type);
 
   private:
+    // HTM abort signals are accepted even when max_outstanding_requests
+    // is reached, as they cannot be retried. Leave room in the request
+    // table for this many of them.
+    static const int htmAbortReserve = 4;
+
     int m_max_outstanding_requests;
 
     CacheMemory* m_dataCache_ptr;
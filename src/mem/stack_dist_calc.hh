@@ -38,8 +38,9 @@
 #ifndef __MEM_STACK_DIST_CALC_HH__
 #define __MEM_STACK_DIST_CALC_HH__
 
+#include <cstddef>
 #include <limits>
-#include <map>
+#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -47,71 +48,62 @@
 /**
   * The stack distance calculator is a passive object that merely
   * observes the addresses pass to it. It calculates stack distances
-  * of incoming addresses based on the partial sum hierarchy tree
-  * algorithm described by Alamasi et al.
-  * http://doi.acm.org/10.1145/773039.773043.
+  * of incoming addresses, i.e. the number of distinct addresses
+  * accessed since the previous access to the same address.
   *
-  * A tree structure is maintained and updated at each transaction
-  * (unique or non-unique). The tree is implemented as an STL vector
-  * with layers of the form <map> Each layer in this tree is an
-  * ordered map <uint64_t, Node*>. Nodes are structs which take form
-  * of leaf, intermediate and root nodes. For example, in a tree with 3
-  * layers, tree[0][5] gives a leaf node pointer for key=5 tree[1][1]
-  * gives an intermediate node pointer for key=1 tree[2][0] gives the
-  * root node in the tree.
-  *
-  * At every transaction a hash-map (aiMap) is looked up to check if
-  * the address was already encountered before. Based on this lookup a
-  * transaction can be termed as unique or non-unique.
+  * Every access is given a position on a time line, and the stack is
+  * represented by marking the position of the latest access to each
+  * address in an order-statistic Fenwick (binary indexed) tree. The
+  * stack distance of an address is then the number of marked
+  * positions after its latest access, which is a prefix sum in the
+  * tree. An open-addressing hash table maps each address to the
+  * position of its latest access. Thus every access is one hash table
+  * lookup and a few O(log n) walks over a flat array, without any
+  * allocation. When the time line is used up, the live positions are
+  * renumbered in order and the tree is rebuilt, sized to twice the
+  * number of distinct addresses on the stack.
   *
   * In addition to the normal stack distance calculation, a feature to
-  * mark an old node in the tree is added. This is useful if it is
+  * mark an old address on the stack is added. This is useful if it is
   * required to see the reuse pattern. For example, BackInvalidates
   * from a lower level (e.g. membus to L2), can be marked (isMarked
-  * flag of Node set to True). Then later if this same address is
-  * accessed (by L1), the value of the isMarked flag would be
+  * flag of the address set to True). Then later if this same address
+  * is accessed (by L1), the value of the isMarked flag would be
   * True. This would give some insight on how the BackInvalidates
   * policy of the lower level affect the read/write accesses in an
   * application.
   *
+  * Sampling: for long full-system runs the calculator can follow
+  * only a spatially hashed sample of the addresses, as in SHARDS
+  * (Waldspurger et al., FAST'15). An address is sampled if its hash
+  * falls below a threshold set by the sampling rate, and the stack
+  * distances measured among the sampled addresses are scaled up by
+  * the inverse of the rate. If a maximum number of sampled addresses
+  * is given, the threshold is lowered whenever the sample grows
+  * beyond it, and the addresses no longer sampled are dropped, which
+  * bounds the memory used. Addresses that are not sampled are ignored
+  * and reported with an infinite stack distance; use isSampled() to
+  * tell them apart.
+  *
   * There are two functions provided to interface with the calculator:
   * 1. pair<uint64_t, bool> calcStackDistAndUpdate(Addr r_address,
   *                                                bool addNewNode)
-  * At every unique transaction a new leaf node is added at tree[0](leaf layer)
-  * and linked to the layer above (if addNewNode is True). The sums of all
-  * the intermediate nodes is updated till the root. The stack-distance is
-  * returned as a Constant representing INFINITY.
-  *
-  * At every non-unique transaction the tree is traversed from the
-  * leaf at the returned index to the root, the old node is deleted
-  * from the tree, and the sums (to the right are collected) and
-  * decremented. The collected sum represets the stack distance of the
-  * found node. If this node was marked then a bool flag set to True
-  * is returned with the stack_distance. During this operation a node
-  * is discarded at the leaf layer always. Moreover during the
-  * traversal upwards using the updateSum() method, if an intermediate
-  * node is found with no children connected to it, then that is
-  * discarded too.
+  * The latest access to the address, if any, is removed from the
+  * stack and its stack distance returned, or Infinity for an address
+  * seen for the first time. If addNewNode is True the address is then
+  * pushed on top of the stack.
   *
   * The return value of this function is a pair representing the
   * stack_distance and the value of the marked flag.
   *
   * 2. pair<uint64_t , bool> calcStackDist(Addr r_address, bool mark)
   * This is a stripped down version of the above function which is used to
-  * just inspect the tree, and mark a leaf node (if mark flag is set). The
-  * functionality to add a new node is removed.
-  *
-  * At every unique transaction the stack-distance is returned as a constant
-  * representing INFINITY.
-  *
-  * At every non-unique transaction the tree is traversed from the
-  * leaf at the returned index to the root, and the sums (to the right)
-  * are collected. The collected sum represets the stack distance of
-  * the found node.
+  * just inspect the stack, and mark an address (if mark flag is set). The
+  * functionality to add a new access is removed.
   *
-  * This function does NOT Modify the stack. (No node is added or
-  * deleted).  It is just used to mark a node already created and get
-  * its stack distance.
+  * This function does NOT Modify the stack. (No access is added or
+  * deleted).  It is just used to mark an address already on the stack
+  * and get its stack distance.
   *
   * The return value of this function is a pair representing the stack
   * distance and the value of the marked flag.
@@ -144,19 +136,10 @@
   * inside our cache.
   *
   * Usage            |   Function to use    |Typical Use           |
-  * Add new entry    |calcStackDistAndUpdate|Read/Write Allocate   |
   * Delete Old Entry |calcStackDistAndUpdate|Writebacks/Cleanevicts|
+  * Add new entry    |calcStackDistAndUpdate|Read/Write Allocate   |
   * Dist.of Old entry|calcStackDist         |Cleanevicts/Invalidate|
   *
-  * Node Balancing: The tree structure is maintained by an
-  * updateTree() operation called when an intermediate node is
-  * required. The update operation is roughly categorized as a root
-  * update or intermediate layer update. When number of leaf nodes
-  * grow over a power of 2 then a new layer is added at the top of the
-  * tree and a new root node is initialized. The old node at the lower
-  * layer is connected to this.  In an intermediate node update
-  * operation a new intermediate node is added to the required layer.
-  *
   * Debugging: Debugging can be enabled by setting the verifyStack flag
   * true. Debugging is implemented using a dummy stack that behaves in
   * a naive way, using STL vectors (i.e each unique address is pushed
@@ -166,99 +149,90 @@
   * pushed down, and the address is pushed at the top of the stack).
   *
   * A printStack(int numOfEntitiesToPrint) is provided to print top n entities
-  * in both (tree and STL based dummy stack).
+  * in both (Fenwick tree and STL based dummy stack).
   */
 class StackDistCalc
 {
 
   private:
 
-    struct Node;
-
-    typedef std::map<uint64_t, Node*> IndexNodeMap;
-    typedef std::map<Addr, uint64_t> AddressIndexMap;
-    typedef std::vector<IndexNodeMap> TreeType;
-
     /**
-     * Gets sum from the node upwards recursively till the root.  This
-     * function is called first by getSumsLeavesToRoot, and then
-     * recursively calls itself.
-     *
-     * @param node pointer to the node which is updated
-     * @param from_left variable which says that the request arrived
-     *        from the left
-     * @param sum_from_below Sum of left and right children below
-     * @param level level in the tree the calling node is located
-     * @param stack_dist stack distance of the node below
-     * @return The stack distance of the current address.
-     *
+     * Entry of the address table, holding the position of the latest
+     * access to an address.
      */
-    uint64_t getSum(Node* node, bool from_left, uint64_t sum_from_below,
-                    uint64_t stack_dist, uint64_t level) const;
+    struct Entry
+    {
+        /** The (line) address */
+        Addr addr;
+
+        /** Position of the latest access on the time line */
+        uint64_t pos;
+
+        /**
+         * Flag to indicate if this address is marked. Used in case
+         * where stack distance of a touched address is required.
+         */
+        bool isMarked;
+
+        /** Whether the table slot is in use */
+        bool valid;
+    };
 
     /**
-     * Gets the sum from the leaf node specified. This function
-     * is called by calcStackDist.
-     *
-     * @param node pointer to the node which is updated
-     * @return The stack distance of the current address.
+     * Look up an address in the address table.
      *
+     * @param r_address The address to look up
+     * @return The entry of the address, nullptr if not on the stack
      */
-    uint64_t getSumsLeavesToRoot(Node* node) const;
+    Entry* find(Addr r_address);
 
     /**
-     * Updates the nodes upwards recursively till the root.
-     * This function is first called by updateSumsLeavesToRoot,
-     * and then it recursively calls itself.
-     *
-     * @param node pointer to the node which is updated
-     * @param from_left variable which says that the request arrived
-     * from the left
-     * @param sum_from_below Sum of left and right children below
-     * @param level level in the tree the calling node is located
-     * @param stack_dist stack distance of the node below
-     * @param discard_node whether the calling node was discarded or not
-     * @return The stack distance of the current address.
+     * Add an address to the address table, at the next position of
+     * the time line.
      *
+     * @param r_address The address to add, which must not be present
+     * @return The new entry
      */
-    uint64_t updateSum(Node* node,
-                       bool from_left, uint64_t sum_from_below, uint64_t level,
-                       uint64_t stack_dist, bool discard_node);
+    Entry* insert(Addr r_address);
 
     /**
-     * Updates the leaf nodes and nodes above. This function is
-     * called by the calcStackDistAndUpdate.
-     *
-     * @param node pointer to the node which is updated
-     * @param is_new_leaf is true if this is a newly added node
-     * @return The stack distance of the current address.
+     * Remove an entry from the address table, shifting back the
+     * entries that follow it in its probe sequence.
      *
+     * @param entry The entry to remove
      */
-    uint64_t updateSumsLeavesToRoot(Node* node, bool is_new_leaf);
+    void erase(Entry* entry);
+
+    /** Home slot of an address in the address table */
+    size_t home(Addr r_address) const;
+
+    /** Add delta to the count at a position of the Fenwick tree */
+    void fenwickAdd(uint64_t pos, int64_t delta);
+
+    /** Number of addresses whose latest access is at or before pos */
+    uint64_t fenwickPrefix(uint64_t pos) const;
+
+    /** Stack distance of an address on the stack, before scaling */
+    uint64_t stackDist(const Entry* entry) const;
 
     /**
-     * updateTree is a tree balancing operation, which maintains the
-     * binary tree structure.
-     * This method is called whenever index%2 == 0 (i.e. every
-     * alternate cycle) The two main operation are :
-     * OP1. Moving the root node one layer up if index counter
-     *       crosses power of 2
-     * OP2. Addition of intermediate nodes as and when required
-     *      and linking them to their parents in the layer above.
+     * Renumber the positions of the addresses on the stack, keeping
+     * their order, and rebuild the address table and the Fenwick tree
+     * to fit them. Addresses that are no longer sampled are dropped.
      */
-    void updateTree();
+    void compact();
 
     /**
-     * This method is used for verification purposes
-     * It recursively traverses upwards from the given node till
-     * the root to check if the ultimate parent node (root-node) points
-     * to null.
-     *
-     * @param node pointer to the node whose sanity is being checked
-     * @param level the level at which this node is located in the tree
-     *
+     * Lower the sampling threshold so that the sample fits in the
+     * maximum number of sampled addresses again.
      */
-    void sanityCheckTree(const Node* node, uint64_t level = 0) const;
+    void shrinkSample();
+
+    /** Hash of an address used for the sampling decision */
+    static uint64_t sampleHash(Addr r_address);
+
+    /** Scale a sampled stack distance to the full address stream */
+    uint64_t scale(uint64_t stack_dist) const;
 
     /**
      * Return the counter for address accesses (unique and
@@ -269,15 +243,6 @@ class StackDistCalc
      */
     uint64_t getIndex() const { return index; }
 
-    /**
-     * Query depth of the tree (tree[0] represents leaf layer while
-     * tree[treeDepth] represents the root layer, all layers in
-     * between contain intermediate nodes)
-     *
-     * @return Tree depth
-     */
-    uint64_t getTreeDepth() const { return tree.size() - 1; }
-
     /**
      * Print the last n items on the stack.
      * This method prints top n entries in the tree based implementation as
@@ -302,7 +267,15 @@ class StackDistCalc
                              bool update_stack = false);
 
   public:
-    StackDistCalc(bool verify_stack = false);
+    /**
+     * @param verify_stack Check every result against a naive stack
+     * @param sample_rate Fraction of the addresses to sample, 1.0 to
+     *                    follow all of them
+     * @param max_samples Maximum number of sampled addresses to keep,
+     *                    0 for no limit
+     */
+    StackDistCalc(bool verify_stack = false, double sample_rate = 1.0,
+                  uint64_t max_samples = 0);
 
     ~StackDistCalc();
 
@@ -311,10 +284,23 @@ class StackDistCalc
      */
     static constexpr uint64_t Infinity = std::numeric_limits<uint64_t>::max();
 
+    /**
+     * Check if an address is currently part of the sample. Always true
+     * unless sampling is enabled.
+     *
+     * @param r_address The address to check
+     * @return True if the address is sampled
+     */
+    bool
+    isSampled(Addr r_address) const
+    {
+        return sampleThreshold == SampleRange ||
+            sampleHash(r_address) < sampleThreshold;
+    }
 
     /**
      * Process the given address. If Mark is true then set the
-     * mark flag of the leaf node.
+     * mark flag of the address.
      * This function returns the stack distance of the incoming
      * address and the previous status of the mark flag.
      *
@@ -327,14 +313,14 @@ class StackDistCalc
 
     /**
      * Process the given address:
-     *  - Lookup the tree for the given address
-     *  - delete old node if found in tree
-     *  - add a new node (if addNewNode flag is set)
+     *  - Lookup the stack for the given address
+     *  - delete old access if found on the stack
+     *  - add a new access (if addNewNode flag is set)
      * This function returns the stack distance of the incoming
      * address and the status of the mark flag.
      *
      * @param r_address The current address to process
-     * @param addNewNode If true, a new node is added to the tree
+     * @param addNewNode If true, a new access is added to the stack
      * @return The stack distance of the current address and the mark flag.
      */
     std::pair<uint64_t, bool> calcStackDistAndUpdate(const Addr r_address,
@@ -342,66 +328,39 @@ class StackDistCalc
 
   private:
 
-    /**
-     * Node which takes form of Leaf, INode or Root
-     */
-    struct Node{
-        // Sum of the left children
-        uint64_t sumLeft;
-
-        // Sum of the right children
-        uint64_t sumRight;
-
-        // Flag to indicate that sumLeft has gone from non-zero value to 0
-        bool discardLeft;
+    /** Number of distinct sample hash values */
+    static constexpr uint64_t SampleRange = 1ULL << 24;
 
-        // Flag to indicate that sumRight has gone from non-zero value to 0
-        bool discardRight;
+    /** Minimum size of the time line and of the address table */
+    static constexpr uint64_t MinSize = 1024;
 
-        // Index of the current element in the Map
-        uint64_t nodeIndex;
-
-        // Pointer to the parent
-        Node* parent;
-
-        // Flag to mark the node as the right/left child
-        bool isLeftNode;
+    /**
+     * Internal counter for address accesses (unique and non-unique)
+     * This counter increments everytime an access is added to the
+     * stack.
+     */
+    uint64_t index;
 
-        /**
-         * Flag to indicate if this address is marked. Used in case
-         * where stack distance of a touched address is required.
-         */
-        bool isMarked;
+    /** Address table, using open addressing with linear probing */
+    std::vector<Entry> table;
 
-        /**
-         * The discard flags are false by default they become true if
-         * the node is reached again in a future lookup.
-         */
-        Node() : sumLeft(0), sumRight(0), discardLeft(false),
-                 discardRight(false), nodeIndex(0),
-                 parent(nullptr), isLeftNode(true), isMarked(false)
-        { }
-    };
+    /** Number of addresses on the stack */
+    uint64_t numEntries;
 
     /**
-     * Internal counter for address accesses (unique and non-unique)
-     * This counter increments everytime the calcStackDist() method is
-     * called. This counter is used as a key for the hash- map at the
-     * leaf layer. Practically at every call to the calculator this
-     * counter is incremented and a new leaf node is added in the tree
-     * at the leaf layer using this counter value as the key.
+     * Fenwick tree over the time line, counting one at the position
+     * of the latest access to each address on the stack.
      */
-    uint64_t index;
+    std::vector<uint64_t> fenwick;
 
-    // Binary tree of partial sums
-    TreeType tree;
+    /** Next free position on the time line */
+    uint64_t nextPos;
 
-    // Hash map which returns last seen index of each address
-    AddressIndexMap aiMap;
+    /** Addresses with a sample hash below this are sampled */
+    uint64_t sampleThreshold;
 
-    // Keeps count of number of the next unique index for each
-    // level in the tree
-    std::vector<uint64_t> nextIndex;
+    /** Maximum number of sampled addresses, 0 for no limit */
+    const uint64_t maxSamples;
 
     // Dummy Stack for verification
     std::vector<uint64_t> stack;
@@ -0,0 +1,243 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "proto/bin_packet_trace.hh"
+
+#include <zlib.h>
+
+#include "base/logging.hh"
+
+namespace
+{
+
+void
+writeWord(std::ostream& os, uint32_t value)
+{
+    value = htole(value);
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool
+readWord(std::istream& is, uint32_t& value)
+{
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    value = letoh(value);
+    return is.gcount() == sizeof(value);
+}
+
+} // anonymous namespace
+
+bool
+BinPacketTrace::isBinTrace(const std::string& filename)
+{
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    uint32_t magic;
+    return is.good() && readWord(is, magic) && magic == magicNumber;
+}
+
+BinPacketTraceWriter::BinPacketTraceWriter(const std::string& filename,
+                                           bool compress,
+                                           size_t block_records) :
+    fileStream(filename.c_str(),
+               std::ios::out | std::ios::binary | std::ios::trunc),
+    compress(compress), blockRecords(block_records),
+    block(block_records * sizeof(BinPacketRecord)), numRecords(0),
+    queue(queueCapacity), freeBlocks(queueCapacity + 2)
+{
+    if (!fileStream.good())
+        panic("Could not open %s for writing\n", filename);
+
+    fatal_if(blockRecords == 0, "Binary packet trace blocks must hold at "
+             "least one record\n");
+
+    writer = std::thread(&BinPacketTraceWriter::writeBlocks, this);
+}
+
+BinPacketTraceWriter::~BinPacketTraceWriter()
+{
+    if (numRecords != 0)
+        flushBlock();
+
+    queue.close();
+    writer.join();
+    fileStream.close();
+}
+
+void
+BinPacketTraceWriter::writeHeader(const ProtoMessage::PacketHeader& header)
+{
+    // The helper thread only touches the file once the first block
+    // is queued, so the header can be written from here
+    std::string data;
+    header.SerializeToString(&data);
+
+    writeWord(fileStream, magicNumber);
+    writeWord(fileStream, version);
+    writeWord(fileStream, sizeof(BinPacketRecord));
+    writeWord(fileStream, compress ? compressedFlag : 0);
+    writeWord(fileStream, data.size());
+    fileStream.write(data.data(), data.size());
+}
+
+void
+BinPacketTraceWriter::flushBlock()
+{
+    // Only the records in use are handed over, the full size is
+    // restored when the block is reused
+    block.resize(numRecords * sizeof(BinPacketRecord));
+    queue.push(std::move(block));
+
+    if (!freeBlocks.tryPop(block))
+        block = ProtoBufferQueue::Buffer();
+    block.resize(blockRecords * sizeof(BinPacketRecord));
+    numRecords = 0;
+}
+
+void
+BinPacketTraceWriter::writeBlocks()
+{
+    ProtoBufferQueue::Buffer data;
+    std::vector<uint8_t> stored;
+
+    while (queue.pop(data)) {
+        const uint8_t* out = data.data();
+        uLongf out_size = data.size();
+
+        if (compress) {
+            stored.resize(compressBound(data.size()));
+            out_size = stored.size();
+            if (compress2(stored.data(), &out_size, data.data(),
+                          data.size(), Z_BEST_SPEED) != Z_OK)
+                panic("Failed to compress binary packet trace block\n");
+            out = stored.data();
+        }
+
+        writeWord(fileStream, data.size() / sizeof(BinPacketRecord));
+        writeWord(fileStream, out_size);
+        fileStream.write(reinterpret_cast<const char*>(out), out_size);
+
+        // The free list can hold every block in flight, so this never
+        // blocks
+        freeBlocks.push(std::move(data));
+    }
+}
+
+BinPacketTraceReader::BinPacketTraceReader(const std::string& filename) :
+    filename(filename),
+    fileStream(filename.c_str(), std::ios::in | std::ios::binary),
+    compressed(false), dataStart(0), numRecords(0), nextRecord(0)
+{
+    if (!fileStream.good())
+        panic("Could not open %s for reading\n", filename);
+
+    uint32_t magic, file_version, record_size, flags, header_size;
+    if (!readWord(fileStream, magic) || magic != magicNumber ||
+        !readWord(fileStream, file_version) ||
+        !readWord(fileStream, record_size) ||
+        !readWord(fileStream, flags) ||
+        !readWord(fileStream, header_size))
+        panic("Input file %s is not a valid gem5 binary packet trace.\n",
+              filename);
+
+    if (file_version != version || record_size != sizeof(BinPacketRecord))
+        panic("Binary packet trace %s has version %d and record size %d, "
+              "expected %d and %d\n", filename, file_version, record_size,
+              version, sizeof(BinPacketRecord));
+
+    compressed = flags & compressedFlag;
+
+    std::string data(header_size, '\0');
+    fileStream.read(&data[0], header_size);
+    if (fileStream.gcount() != header_size ||
+        !headerMsg.ParseFromString(data))
+        panic("Unable to read header from binary packet trace %s\n",
+              filename);
+
+    dataStart = fileStream.tellg();
+}
+
+void
+BinPacketTraceReader::reset()
+{
+    fileStream.clear();
+    fileStream.seekg(dataStart);
+    numRecords = 0;
+    nextRecord = 0;
+}
+
+bool
+BinPacketTraceReader::readBlock()
+{
+    uint32_t num_records, stored_size;
+    if (!readWord(fileStream, num_records))
+        return false;
+    if (!readWord(fileStream, stored_size))
+        panic("Truncated block in binary packet trace %s\n", filename);
+
+    const size_t block_size = num_records * sizeof(BinPacketRecord);
+    block.resize(block_size);
+
+    std::vector<uint8_t>& in = compressed ? stored : block;
+    in.resize(stored_size);
+    fileStream.read(reinterpret_cast<char*>(in.data()), stored_size);
+    if (fileStream.gcount() != stored_size)
+        panic("Truncated block in binary packet trace %s\n", filename);
+
+    if (compressed) {
+        uLongf out_size = block_size;
+        if (uncompress(block.data(), &out_size, stored.data(),
+                       stored_size) != Z_OK || out_size != block_size)
+            panic("Corrupt block in binary packet trace %s\n", filename);
+    } else if (stored_size != block_size) {
+        panic("Corrupt block in binary packet trace %s\n", filename);
+    }
+
+    numRecords = num_records;
+    nextRecord = 0;
+    return true;
+}
+
+bool
+BinPacketTraceReader::read(BinPacketRecord& record)
+{
+    while (nextRecord == numRecords) {
+        if (!readBlock())
+            return false;
+    }
+
+    BinPacketRecord le;
+    std::memcpy(&le, block.data() + nextRecord * sizeof(le), sizeof(le));
+    ++nextRecord;
+
+    record.tick = letoh(le.tick);
+    record.addr = letoh(le.addr);
+    record.pc = letoh(le.pc);
+    record.pktId = letoh(le.pktId);
+    record.cmd = letoh(le.cmd);
+    record.size = letoh(le.size);
+    record.flags = letoh(le.flags);
+    record.pad = 0;
+    return true;
+}
@@ -0,0 +1,281 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a batched binary packet trace writer and reader.
+ */
+
+#ifndef __PROTO_BIN_PACKET_TRACE_HH__
+#define __PROTO_BIN_PACKET_TRACE_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#include "sim/byteswap.hh"
+
+/**
+ * A fixed-size record of a binary packet trace, holding the same
+ * information as a ProtoMessage::Packet. Records are stored in little
+ * endian byte order.
+ */
+struct BinPacketRecord
+{
+    uint64_t tick;
+    uint64_t addr;
+    uint64_t pc;
+    uint64_t pktId;
+    uint32_t cmd;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t pad;
+};
+
+/**
+ * A binary packet trace is a cheaper alternative to a protobuf packet
+ * trace for tracing a large number of accesses. After a file header
+ * holding a ProtoMessage::PacketHeader, the packets are stored as
+ * fixed-size records in blocks, each optionally compressed with
+ * zlib. The records of a block are gathered on the simulation thread,
+ * and compressing and writing the block is left to a helper thread.
+ *
+ * The file layout, all fields being 32-bit little endian values, is:
+ * magic number, version, record size, flags, header size, followed by
+ * the serialised header. Each block then starts with the number of
+ * records and the size of the stored data, followed by the data.
+ */
+class BinPacketTrace
+{
+
+  public:
+
+    /**
+     * Check if a file is a binary packet trace.
+     *
+     * @param filename Path to the file to check
+     * @return True if the file starts with the right magic number
+     */
+    static bool isBinTrace(const std::string& filename);
+
+  protected:
+
+    /// Use the ASCII characters g5pt as our magic number
+    static const uint32_t magicNumber = 0x74703567;
+
+    /// Version of the file layout
+    static const uint32_t version = 1;
+
+    /// Flag set if the blocks are compressed
+    static const uint32_t compressedFlag = 0x1;
+
+    BinPacketTrace() {}
+
+  private:
+
+    /**
+     * Hide the copy constructor and assignment operator.
+     * @{
+     */
+    BinPacketTrace(const BinPacketTrace&);
+    BinPacketTrace& operator=(const BinPacketTrace&);
+    /** @} */
+};
+
+/**
+ * Writer of a binary packet trace. Records are appended to the
+ * current block, which is handed to the helper thread once full. The
+ * blocks are recycled once written, so a steady stream of records
+ * does not allocate any memory.
+ */
+class BinPacketTraceWriter : public BinPacketTrace
+{
+
+  public:
+
+    /**
+     * Create a writer for a given file name, and start its helper
+     * thread.
+     *
+     * @param filename Path to the file to write to
+     * @param compress Compress the blocks with zlib
+     * @param block_records Number of records per block
+     */
+    BinPacketTraceWriter(const std::string& filename, bool compress,
+                         size_t block_records);
+
+    /**
+     * Write the remaining records, stop the helper thread and close
+     * the file.
+     */
+    ~BinPacketTraceWriter();
+
+    /**
+     * Write the trace header. This must be done before any record is
+     * appended.
+     *
+     * @param header Header of the trace
+     */
+    void writeHeader(const ProtoMessage::PacketHeader& header);
+
+    /**
+     * Append a record to the trace.
+     *
+     * @param record Record to append, in host byte order
+     */
+    void
+    append(const BinPacketRecord& record)
+    {
+        BinPacketRecord le;
+        le.tick = htole(record.tick);
+        le.addr = htole(record.addr);
+        le.pc = htole(record.pc);
+        le.pktId = htole(record.pktId);
+        le.cmd = htole(record.cmd);
+        le.size = htole(record.size);
+        le.flags = htole(record.flags);
+        le.pad = 0;
+        std::memcpy(block.data() + numRecords * sizeof(le), &le, sizeof(le));
+        if (++numRecords == blockRecords)
+            flushBlock();
+    }
+
+  private:
+
+    /**
+     * Hand the current block to the helper thread and start a new one.
+     */
+    void flushBlock();
+
+    /**
+     * Body of the helper thread, compressing and writing the blocks
+     * until the queue is closed.
+     */
+    void writeBlocks();
+
+    /// Maximum number of blocks waiting for the helper thread
+    static const size_t queueCapacity = 4;
+
+    /// Output file
+    std::ofstream fileStream;
+
+    /// Compress the blocks with zlib
+    const bool compress;
+
+    /// Number of records per block
+    const size_t blockRecords;
+
+    /// Current block, always sized to hold a full block
+    ProtoBufferQueue::Buffer block;
+
+    /// Number of records in the current block
+    size_t numRecords;
+
+    /// Blocks waiting to be written
+    ProtoBufferQueue queue;
+
+    /// Blocks that have been written, ready for reuse
+    ProtoBufferQueue freeBlocks;
+
+    /// Helper thread writing the blocks
+    std::thread writer;
+};
+
+/**
+ * Reader of a binary packet trace.
+ */
+class BinPacketTraceReader : public BinPacketTrace
+{
+
+  public:
+
+    /**
+     * Open a binary packet trace and read its header.
+     *
+     * @param filename Path to the file to read from
+     */
+    BinPacketTraceReader(const std::string& filename);
+
+    /**
+     * Get the header of the trace.
+     */
+    const ProtoMessage::PacketHeader& header() const { return headerMsg; }
+
+    /**
+     * Reset the reader to the first record of the trace.
+     */
+    void reset();
+
+    /**
+     * Read the next record of the trace.
+     *
+     * @param record Record to populate, in host byte order
+     * @return True if a record was read, false at the end of the trace
+     */
+    bool read(BinPacketRecord& record);
+
+  private:
+
+    /**
+     * Read and (if needed) decompress the next block.
+     *
+     * @return False at the end of the trace
+     */
+    bool readBlock();
+
+    /// Name of the file, for error messages
+    const std::string filename;
+
+    /// Input file
+    std::ifstream fileStream;
+
+    /// Blocks are compressed with zlib
+    bool compressed;
+
+    /// Trace header
+    ProtoMessage::PacketHeader headerMsg;
+
+    /// File offset of the first block
+    std::streamoff dataStart;
+
+    /// Records of the current block
+    std::vector<uint8_t> block;
+
+    /// Compressed data of the current block
+    std::vector<uint8_t> stored;
+
+    /// Number of records in the current block
+    size_t numRecords;
+
+    /// Next record to read from the current block
+    size_t nextRecord;
+};
+
+#endif //__PROTO_BIN_PACKET_TRACE_HH__
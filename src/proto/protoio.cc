@@ -37,12 +37,91 @@
 
 #include "proto/protoio.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #include "base/logging.hh"
 
 using namespace std;
 using namespace google::protobuf;
 
+/// Number of buffers either helper thread may run ahead by
+static const size_t queueCapacity = 4;
+
+ProtoBufferQueue::ProtoBufferQueue(size_t capacity) :
+    capacity(capacity), closed(false), aborted(false)
+{
+}
+
+bool
+ProtoBufferQueue::push(Buffer&& buf)
+{
+    unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this] {
+        return aborted || buffers.size() < capacity; });
+    if (aborted)
+        return false;
+    buffers.push_back(std::move(buf));
+    notEmpty.notify_one();
+    return true;
+}
+
+bool
+ProtoBufferQueue::pop(Buffer& buf)
+{
+    unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this] {
+        return aborted || closed || !buffers.empty(); });
+    if (aborted || buffers.empty())
+        return false;
+    buf = std::move(buffers.front());
+    buffers.pop_front();
+    notFull.notify_one();
+    return true;
+}
+
+bool
+ProtoBufferQueue::tryPop(Buffer& buf)
+{
+    lock_guard<std::mutex> lock(mutex);
+    if (buffers.empty())
+        return false;
+    buf = std::move(buffers.front());
+    buffers.pop_front();
+    notFull.notify_one();
+    return true;
+}
+
+void
+ProtoBufferQueue::close()
+{
+    lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_all();
+}
+
+void
+ProtoBufferQueue::abort()
+{
+    lock_guard<std::mutex> lock(mutex);
+    aborted = true;
+    buffers.clear();
+    notEmpty.notify_all();
+    notFull.notify_all();
+}
+
+void
+ProtoBufferQueue::reopen()
+{
+    lock_guard<std::mutex> lock(mutex);
+    buffers.clear();
+    closed = false;
+    aborted = false;
+}
+
 ProtoOutputStream::ProtoOutputStream(const string& filename) :
+    queue(queueCapacity),
     fileStream(filename.c_str(), ios::out | ios::binary | ios::trunc),
     wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
 {
@@ -67,10 +146,20 @@ ProtoOutputStream::ProtoOutputStream(const string& filename) :
 
     // Note that each type of stream (packet, instruction etc) should
     // add its own header and perform the appropriate checks
+
+    pending.reserve(bufferSize);
+    writer = thread(&ProtoOutputStream::writeBuffers, this);
 }
 
 ProtoOutputStream::~ProtoOutputStream()
 {
+    // Hand over what is left and wait for the helper thread to
+    // write everything before tearing down the streams
+    if (!pending.empty())
+        queue.push(std::move(pending));
+    queue.close();
+    writer.join();
+
     // As the compression is optional, see if the stream exists
     if (gzipStream != NULL)
         delete gzipStream;
@@ -81,27 +170,101 @@ ProtoOutputStream::~ProtoOutputStream()
 void
 ProtoOutputStream::write(const Message& msg)
 {
-    // Due to the byte limit of the coded stream we create it for
-    // every single mesage (based on forum discussions around the size
-    // limitation)
-    io::CodedOutputStream codedStream(zeroCopyStream);
-
-    // Write the size of the message to the stream
 #   if GOOGLE_PROTOBUF_VERSION < 3001000
         auto msg_size = msg.ByteSize();
 #   else
         auto msg_size = msg.ByteSizeLong();
 #   endif
-    codedStream.WriteVarint32(msg_size);
 
-    // Write the message itself to the stream
-    msg.SerializeWithCachedSizes(&codedStream);
+    // Serialise the size of the message followed by the message
+    // itself at the end of the pending buffer
+    const size_t offset = pending.size();
+    pending.resize(offset + io::CodedOutputStream::VarintSize32(msg_size) +
+                   msg_size);
+    uint8_t* start = pending.data() + offset;
+    start = io::CodedOutputStream::WriteVarint32ToArray(msg_size, start);
+    msg.SerializeWithCachedSizesToArray(start);
+
+    if (pending.size() >= bufferSize) {
+        queue.push(std::move(pending));
+        pending = ProtoBufferQueue::Buffer();
+        pending.reserve(bufferSize);
+    }
+}
+
+void
+ProtoOutputStream::writeBuffers()
+{
+    ProtoBufferQueue::Buffer buf;
+    while (queue.pop(buf)) {
+        // Due to the byte limit of the coded stream we create it for
+        // every buffer (based on forum discussions around the size
+        // limitation)
+        io::CodedOutputStream codedStream(zeroCopyStream);
+        codedStream.WriteRaw(buf.data(), buf.size());
+    }
+}
+
+ProtoInputStream::BufferedInputStream::BufferedInputStream(
+    ProtoBufferQueue& queue) :
+    queue(queue), pos(0), byteCount(0)
+{
+}
+
+bool
+ProtoInputStream::BufferedInputStream::Next(const void** data, int* size)
+{
+    if (pos == current.size()) {
+        // The helper thread never hands over empty buffers
+        if (!queue.pop(current)) {
+            clear();
+            return false;
+        }
+        pos = 0;
+    }
+
+    *data = current.data() + pos;
+    *size = current.size() - pos;
+    byteCount += *size;
+    pos = current.size();
+    return true;
+}
+
+void
+ProtoInputStream::BufferedInputStream::BackUp(int count)
+{
+    assert(count >= 0 && (size_t)count <= pos);
+    pos -= count;
+    byteCount -= count;
+}
+
+bool
+ProtoInputStream::BufferedInputStream::Skip(int count)
+{
+    const void* data;
+    int size;
+    while (count > 0) {
+        if (!Next(&data, &size))
+            return false;
+        const int skipped = min(count, size);
+        BackUp(size - skipped);
+        count -= skipped;
+    }
+    return true;
+}
+
+void
+ProtoInputStream::BufferedInputStream::clear()
+{
+    current.clear();
+    pos = 0;
 }
 
 ProtoInputStream::ProtoInputStream(const string& filename) :
     fileStream(filename.c_str(), ios::in | ios::binary), fileName(filename),
     useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    queue(queueCapacity), bufferedStream(queue)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
@@ -116,6 +279,7 @@ ProtoInputStream::ProtoInputStream(const string& filename) :
     fileStream.seekg(0, ifstream::beg);
 
     createStreams();
+    startReader();
 }
 
 void
@@ -159,8 +323,50 @@ ProtoInputStream::destroyStreams()
 }
 
 
+void
+ProtoInputStream::readBuffers()
+{
+    // Gather the (typically small) chunks produced by the zero-copy
+    // stream into larger buffers to keep the synchronisation cheap
+    ProtoBufferQueue::Buffer buf;
+    buf.reserve(bufferSize);
+
+    const void* data;
+    int size;
+    while (zeroCopyStream->Next(&data, &size)) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buf.insert(buf.end(), bytes, bytes + size);
+        if (buf.size() >= bufferSize) {
+            if (!queue.push(std::move(buf)))
+                return;
+            buf = ProtoBufferQueue::Buffer();
+            buf.reserve(bufferSize);
+        }
+    }
+
+    if (!buf.empty())
+        queue.push(std::move(buf));
+    queue.close();
+}
+
+void
+ProtoInputStream::startReader()
+{
+    queue.reopen();
+    bufferedStream.clear();
+    reader = thread(&ProtoInputStream::readBuffers, this);
+}
+
+void
+ProtoInputStream::stopReader()
+{
+    queue.abort();
+    reader.join();
+}
+
 ProtoInputStream::~ProtoInputStream()
 {
+    stopReader();
     destroyStreams();
     fileStream.close();
 }
@@ -169,11 +375,13 @@ ProtoInputStream::~ProtoInputStream()
 void
 ProtoInputStream::reset()
 {
+    stopReader();
     destroyStreams();
     // seek to the start of the input file and clear any flags
     fileStream.clear();
     fileStream.seekg(0, ifstream::beg);
     createStreams();
+    startReader();
 }
 
 bool
@@ -186,7 +394,7 @@ ProtoInputStream::read(Message& msg)
     // Due to the byte limit of the coded stream we create it for
     // every single mesage (based on forum discussions around the size
     // limitation)
-    io::CodedInputStream codedStream(zeroCopyStream);
+    io::CodedInputStream codedStream(&bufferedStream);
     if (codedStream.ReadVarint32(&size)) {
         io::CodedInputStream::Limit limit = codedStream.PushLimit(size);
         if (msg.ParseFromCodedStream(&codedStream)) {
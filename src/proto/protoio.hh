@@ -49,7 +49,13 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -79,6 +85,78 @@ class ProtoStream
     /** @} */
 };
 
+/**
+ * A bounded queue of byte buffers, used to hand (de)compressed data
+ * between the simulation thread and the helper thread of a proto
+ * stream. Bounding the queue limits how far the helper thread runs
+ * ahead, and thus the memory used, to a few buffers.
+ */
+class ProtoBufferQueue
+{
+
+  public:
+
+    typedef std::vector<uint8_t> Buffer;
+
+    /**
+     * @param capacity Maximum number of buffers in flight
+     */
+    ProtoBufferQueue(size_t capacity);
+
+    /**
+     * Append a buffer, blocking as long as the queue is full.
+     *
+     * @param buf Buffer to append, moved into the queue
+     * @return False if the queue was aborted and the buffer dropped
+     */
+    bool push(Buffer&& buf);
+
+    /**
+     * Take the oldest buffer, blocking as long as the queue is empty.
+     *
+     * @param buf Buffer to move the data into
+     * @return False if the queue is closed (or aborted) and drained
+     */
+    bool pop(Buffer& buf);
+
+    /**
+     * Take the oldest buffer if there is one, without blocking.
+     *
+     * @param buf Buffer to move the data into
+     * @return False if the queue is empty
+     */
+    bool tryPop(Buffer& buf);
+
+    /**
+     * Signal that no more buffers will be pushed. Buffers already in
+     * the queue can still be popped.
+     */
+    void close();
+
+    /**
+     * Drop all buffers and wake up both sides. Used to stop a helper
+     * thread that is blocked on a full queue.
+     */
+    void abort();
+
+    /**
+     * Make an aborted or closed queue usable again.
+     */
+    void reopen();
+
+  private:
+
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+
+    std::deque<Buffer> buffers;
+    const size_t capacity;
+    bool closed;
+    bool aborted;
+
+};
+
 /**
  * A ProtoOutputStream wraps a coded stream, potentially with
  * compression, based on looking at the file name. Writing to the
@@ -86,6 +164,10 @@ class ProtoStream
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * Messages are serialised on the calling thread into a buffer, and
+ * full buffers are compressed and written to the file by a helper
+ * thread, so that the caller only pays for the serialisation.
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -116,6 +198,24 @@ class ProtoOutputStream : public ProtoStream
 
   private:
 
+    /// Size at which a buffer of serialised messages is handed over
+    static const size_t bufferSize = 256 * 1024;
+
+    /**
+     * Main loop of the helper thread, writing buffers to the
+     * zero-copy stream until the queue is closed.
+     */
+    void writeBuffers();
+
+    /// Serialised messages not yet handed to the helper thread
+    ProtoBufferQueue::Buffer pending;
+
+    /// Buffers waiting to be written by the helper thread
+    ProtoBufferQueue queue;
+
+    /// Helper thread doing the compression and file output
+    std::thread writer;
+
     /// Underlying file output stream
     std::ofstream fileStream;
 
@@ -136,6 +236,9 @@ class ProtoOutputStream : public ProtoStream
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
  * is encoded in the stream when it is written.
+ *
+ * A helper thread reads and decompresses the file ahead of the
+ * caller, which parses the messages from the decompressed buffers.
  */
 class ProtoInputStream : public ProtoStream
 {
@@ -171,6 +274,59 @@ class ProtoInputStream : public ProtoStream
 
   private:
 
+    /**
+     * Zero-copy stream handing out the buffers produced by the helper
+     * thread. Only the last buffer returned can be backed up into,
+     * which is all a coded stream needs.
+     */
+    class BufferedInputStream :
+        public google::protobuf::io::ZeroCopyInputStream
+    {
+
+      public:
+
+        BufferedInputStream(ProtoBufferQueue& queue);
+
+        bool Next(const void** data, int* size) override;
+        void BackUp(int count) override;
+        bool Skip(int count) override;
+        int64_t ByteCount() const override { return byteCount; }
+
+        /** Forget the current buffer, e.g. when the file is reset */
+        void clear();
+
+      private:
+
+        ProtoBufferQueue& queue;
+
+        /// Buffer currently being consumed and position within it
+        ProtoBufferQueue::Buffer current;
+        size_t pos;
+
+        int64_t byteCount;
+
+    };
+
+    /// Amount of decompressed data gathered before handing it over
+    static const size_t bufferSize = 256 * 1024;
+
+    /**
+     * Main loop of the helper thread, reading and decompressing the
+     * file into buffers until the end of the file is reached or the
+     * queue is aborted.
+     */
+    void readBuffers();
+
+    /**
+     * Start the helper thread on freshly created streams.
+     */
+    void startReader();
+
+    /**
+     * Stop the helper thread and drop any data read ahead.
+     */
+    void stopReader();
+
     /**
      * Create the internal streams that are wrapping the input file.
      */
@@ -199,6 +355,15 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Decompressed buffers read ahead by the helper thread
+    ProtoBufferQueue queue;
+
+    /// Stream the messages are parsed from
+    BufferedInputStream bufferedStream;
+
+    /// Helper thread doing the file input and decompression
+    std::thread reader;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
@@ -0,0 +1,64 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_PROBE_BRANCH_HH__
+#define __SIM_PROBE_BRANCH_HH__
+
+#include <memory>
+
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+#include "sim/probe/probe.hh"
+
+namespace ProbePoints {
+
+/**
+ * A committed control instruction and the way it went.
+ */
+struct BranchInfo {
+    /** The control instruction */
+    StaticInstPtr inst;
+    /** Address of the instruction */
+    Addr pc;
+    /** Address of the instruction following it in program order */
+    Addr fallThrough;
+    /** Address of the instruction executed after it */
+    Addr target;
+    /** Did it redirect execution away from the fall through? */
+    bool taken;
+};
+
+/**
+ * Branch probe point
+ *
+ * Notified by CPUs with the outcome of each control instruction as it
+ * commits, named "Branch".
+ */
+typedef ProbePointArg<BranchInfo> Branch;
+typedef std::unique_ptr<Branch> BranchUPtr;
+
+}
+
+#endif //__SIM_PROBE_BRANCH_HH__
@@ -238,6 +238,33 @@ class ProbeListenerArg : public ProbeListenerArgBase<Arg>
     virtual void notify(const Arg &val) { (object->*function)(val); }
 };
 
+/**
+ * ProbeListenerMethod is a ProbeListenerArg where the method to call is
+ * a template argument rather than a pointer stored in the listener. The
+ * call to the method is resolved at compile time, and can be inlined
+ * into notify, which is worthwhile for listeners on hot probe points
+ * such as instruction commit.
+ */
+template <class T, class Arg, void (T::*Func)(const Arg &)>
+class ProbeListenerMethod : public ProbeListenerArgBase<Arg>
+{
+  private:
+    T *object;
+
+  public:
+    /**
+     * @param obj the object of type T containing the method to call on
+     *        notify.
+     * @param name the name of the ProbePoint to add this listener to.
+     */
+    ProbeListenerMethod(T *obj, const std::string &name)
+        : ProbeListenerArgBase<Arg>(obj->getProbeManager(), name),
+          object(obj)
+    {}
+
+    void notify(const Arg &val) override final { (object->*Func)(val); }
+};
+
 /**
  * ProbePointArg generates a point for the class of Arg. As ProbePointArgs talk
  * directly to ProbeListenerArgs of the same type, we can store the vector of
@@ -251,12 +278,22 @@ class ProbePointArg : public ProbePoint
     /** The attached listeners. */
     std::vector<ProbeListenerArgBase<Arg> *> listeners;
 
+    /** Whether any listener is attached, checked on every notify. */
+    bool attached;
+
   public:
     ProbePointArg(ProbeManager *manager, std::string name)
-        : ProbePoint(manager, name)
+        : ProbePoint(manager, name), attached(false)
     {
     }
 
+    /**
+     * @brief check if any listener is attached to this ProbePoint. Call
+     *        sites can use this to skip work that only serves the probe.
+     * @return true if notify would call at least one listener.
+     */
+    bool hasListeners() const { return attached; }
+
     /**
      * @brief adds a ProbeListener to this ProbePoints notify list.
      * @param l the ProbeListener to add to the notify list.
@@ -267,6 +304,7 @@ class ProbePointArg : public ProbePoint
         if (std::find(listeners.begin(), listeners.end(), l) == listeners.end()) {
             listeners.push_back(static_cast<ProbeListenerArgBase<Arg> *>(l));
         }
+        attached = !listeners.empty();
     }
 
     /**
@@ -277,6 +315,7 @@ class ProbePointArg : public ProbePoint
     {
         listeners.erase(std::remove(listeners.begin(), listeners.end(), l),
                         listeners.end());
+        attached = !listeners.empty();
     }
 
     /**
@@ -285,6 +324,26 @@ class ProbePointArg : public ProbePoint
      */
     void notify(const Arg &arg)
     {
+        if (M5_LIKELY(!attached))
+            return;
+        for (auto l = listeners.begin(); l != listeners.end(); ++l) {
+            (*l)->notify(arg);
+        }
+    }
+
+    /**
+     * @brief called at the ProbePoint call site when the argument is
+     *        costly to build. The argument is only built, by calling
+     *        make_arg, if there is a listener to pass it to.
+     * @param make_arg callable returning the argument to pass to each
+     *        listener.
+     */
+    template <typename F>
+    void notifyWith(F &&make_arg)
+    {
+        if (M5_LIKELY(!attached))
+            return;
+        const Arg &arg = make_arg();
         for (auto l = listeners.begin(); l != listeners.end(); ++l) {
             (*l)->notify(arg);
         }